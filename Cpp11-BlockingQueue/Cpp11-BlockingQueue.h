@@ -24,6 +24,9 @@
  *
  * Maintenance History:
  * --------------------
+ * ver 1.4 : 17 Oct 2026
+ * - mutex and condition variable types are template parameters,
+ *   defaulting to std::mutex and std::condition_variable
  * ver 1.3 : 04 Mar 2016
  * - changed behavior of front() to throw exception
  *   on empty queue.
@@ -47,14 +50,14 @@
 #include <iostream>
 #include <sstream>
 
-template <typename T>
+template <typename T, typename Mutex = std::mutex, typename CondVar = std::condition_variable>
 class BlockingQueue {
 public:
   BlockingQueue() {}
-  BlockingQueue(BlockingQueue<T>&& bq);
-  BlockingQueue<T>& operator=(BlockingQueue<T>&& bq);
-  BlockingQueue(const BlockingQueue<T>&) = delete;
-  BlockingQueue<T>& operator=(const BlockingQueue<T>&) = delete;
+  BlockingQueue(BlockingQueue&& bq);
+  BlockingQueue& operator=(BlockingQueue&& bq);
+  BlockingQueue(const BlockingQueue&) = delete;
+  BlockingQueue& operator=(const BlockingQueue&) = delete;
   T deQ();
   void enQ(const T& t);
   T& front();
@@ -62,15 +65,15 @@ public:
   size_t size();
 private:
   std::queue<T> q_;
-  std::mutex mtx_;
-  std::condition_variable cv_;
+  Mutex mtx_;
+  CondVar cv_;
 };
 //----< move constructor >---------------------------------------------
 
-template<typename T>
-BlockingQueue<T>::BlockingQueue(BlockingQueue<T>&& bq) // need to lock so can't initialize
+template<typename T, typename Mutex, typename CondVar>
+BlockingQueue<T, Mutex, CondVar>::BlockingQueue(BlockingQueue&& bq) // need to lock so can't initialize
 {
-  std::lock_guard<std::mutex> l(mtx_);
+  std::lock_guard<Mutex> l(mtx_);
   q_ = bq.q_;
   while (bq.q_.size() > 0)  // clear bq
     bq.q_.pop();
@@ -78,11 +81,11 @@ BlockingQueue<T>::BlockingQueue(BlockingQueue<T>&& bq) // need to lock so can't
 }
 //----< move assignment >----------------------------------------------
 
-template<typename T>
-BlockingQueue<T>& BlockingQueue<T>::operator=(BlockingQueue<T>&& bq)
+template<typename T, typename Mutex, typename CondVar>
+BlockingQueue<T, Mutex, CondVar>& BlockingQueue<T, Mutex, CondVar>::operator=(BlockingQueue&& bq)
 {
   if (this == &bq) return *this;
-  std::lock_guard<std::mutex> l(mtx_);
+  std::lock_guard<Mutex> l(mtx_);
   q_ = bq.q_;
   while (bq.q_.size() > 0)  // clear bq
     bq.q_.pop();
@@ -91,10 +94,10 @@ BlockingQueue<T>& BlockingQueue<T>::operator=(BlockingQueue<T>&& bq)
 }
 //----< remove element from front of queue >---------------------------
 
-template<typename T>
-T BlockingQueue<T>::deQ()
+template<typename T, typename Mutex, typename CondVar>
+T BlockingQueue<T, Mutex, CondVar>::deQ()
 {
-  std::unique_lock<std::mutex> l(mtx_);
+  std::unique_lock<Mutex> l(mtx_);
   /* 
      This lock type is required for use with condition variables.
      The operating system needs to lock and unlock the mutex:
@@ -121,40 +124,40 @@ T BlockingQueue<T>::deQ()
 }
 //----< push element onto back of queue >------------------------------
 
-template<typename T>
-void BlockingQueue<T>::enQ(const T& t)
+template<typename T, typename Mutex, typename CondVar>
+void BlockingQueue<T, Mutex, CondVar>::enQ(const T& t)
 {
   {
-    std::unique_lock<std::mutex> l(mtx_);
+    std::unique_lock<Mutex> l(mtx_);
     q_.push(t);
   }
   cv_.notify_one();
 }
 //----< peek at next item to be popped >-------------------------------
 
-template <typename T>
-T& BlockingQueue<T>::front()
+template <typename T, typename Mutex, typename CondVar>
+T& BlockingQueue<T, Mutex, CondVar>::front()
 {
-  std::lock_guard<std::mutex> l(mtx_);
+  std::lock_guard<Mutex> l(mtx_);
   if(q_.size() > 0)
     return q_.front();
   throw std::exception("attempt to deQue empty queue");
 }
 //----< remove all elements from queue >-------------------------------
 
-template <typename T>
-void BlockingQueue<T>::clear()
+template <typename T, typename Mutex, typename CondVar>
+void BlockingQueue<T, Mutex, CondVar>::clear()
 {
-  std::lock_guard<std::mutex> l(mtx_);
+  std::lock_guard<Mutex> l(mtx_);
   while (q_.size() > 0)
     q_.pop();
 }
 //----< return number of elements in queue >---------------------------
 
-template<typename T>
-size_t BlockingQueue<T>::size()
+template<typename T, typename Mutex, typename CondVar>
+size_t BlockingQueue<T, Mutex, CondVar>::size()
 {
-  std::lock_guard<std::mutex> l(mtx_);
+  std::lock_guard<Mutex> l(mtx_);
   return q_.size();
 }
 
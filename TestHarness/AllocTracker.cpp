@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////
+// AllocTracker.cpp - replaces global operator new and delete  //
+//                                                             //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ     //
+/////////////////////////////////////////////////////////////////
+/*
+   Link this file to enable AllocScope counting.  The replaced
+   operators forward to malloc and free, and report usable block
+   sizes to AllocTracker.h's per-thread counters.  The nothrow
+   forms return nullptr if the new_handler throws.
+*/
+
+#include "AllocTracker.h"
+#include <new>
+#include <cstdlib>
+
+#if defined(_WIN32)
+  #include <malloc.h>
+  #define ALLOC_USABLE_SIZE(p) _msize(p)
+#elif defined(__APPLE__)
+  #include <malloc/malloc.h>
+  #define ALLOC_USABLE_SIZE(p) malloc_size(p)
+#else
+  #include <malloc.h>
+  #define ALLOC_USABLE_SIZE(p) malloc_usable_size(p)
+#endif
+
+namespace {
+
+  struct InstallHooks {
+    InstallHooks() {
+      Test::allocHooksInstalled.store(true);
+    }
+  } installHooks;
+
+  void* allocate(size_t size) {
+    if (size == 0)
+      size = 1;
+    void* p = nullptr;
+    while ((p = std::malloc(size)) == nullptr) {
+      std::new_handler handler = std::get_new_handler();
+      if (handler == nullptr)
+        return nullptr;
+      handler();
+    }
+    Test::recordAlloc(ALLOC_USABLE_SIZE(p));
+    return p;
+  }
+
+  void release(void* p) {
+    if (p == nullptr)
+      return;
+    Test::recordFree(ALLOC_USABLE_SIZE(p));
+    std::free(p);
+  }
+}
+
+void* operator new(size_t size) {
+  void* p = allocate(size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t size) {
+  void* p = allocate(size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size);
+  }
+  catch (...) {
+    return nullptr;   // new_handler threw, e.g., std::bad_alloc
+  }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size);
+  }
+  catch (...) {
+    return nullptr;
+  }
+}
+void operator delete(void* p) noexcept {
+  release(p);
+}
+void operator delete[](void* p) noexcept {
+  release(p);
+}
+void operator delete(void* p, size_t) noexcept {
+  release(p);
+}
+void operator delete[](void* p, size_t) noexcept {
+  release(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  release(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  release(p);
+}
@@ -0,0 +1,138 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// AllocTracker.h - per-thread heap allocation accounting  //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Counts heap use of the calling thread inside a scope:
+   - AllocStats holds allocation and deallocation counts,
+     bytes allocated, and peak live bytes
+   - AllocScope counts from its construction to its destruction,
+     scopes may nest
+   - AllocScope::atMost(n) lets a test fail when a path that
+     should not allocate does, e.g., return scope.atMost(0);
+
+   Counting is opt-in at link time.  AllocTracker.cpp replaces
+   global operator new and delete.  Without it the header still
+   compiles and links, allocTrackingInstalled() returns false,
+   and all counts stay zero.
+
+   Only allocations made by the thread that owns the scope are
+   counted.  Over-aligned new and delete are not replaced.
+
+   Bytes are usable block sizes, as the allocator reports them,
+   for allocation and release alike, so bytes allocated and peak
+   live bytes are in one unit and may exceed the sizes requested.
+
+   Package Dependencies:
+  -----------------------
+   AllocTracker.h, AllocTracker.cpp
+
+   Maintenance History:
+  ----------------------
+   ver 1.1 - 17 Oct 2026
+   - bytes allocated counts usable size, the unit of live bytes
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <cstddef>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+
+namespace Test {
+
+  struct AllocStats {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesAllocated = 0;
+    long long peakLiveBytes = 0;
+  };
+
+  /*-- raw counters updated by the replaced operators --*/
+  struct AllocCounters {
+    size_t depth = 0;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesAllocated = 0;
+    long long liveBytes = 0;
+    long long peakLiveBytes = 0;
+  };
+
+  inline thread_local AllocCounters allocCounters;
+
+  /*-- set by AllocTracker.cpp during static initialization --*/
+  inline std::atomic<bool> allocHooksInstalled{ false };
+
+  inline bool allocTrackingInstalled() {
+    return allocHooksInstalled.load(std::memory_order_relaxed);
+  }
+
+  /*-- called from operator new with the block's usable size, must not allocate --*/
+  inline void recordAlloc(size_t usable) {
+    AllocCounters& c = allocCounters;
+    if (c.depth == 0)
+      return;
+    ++c.allocations;
+    c.bytesAllocated += usable;
+    c.liveBytes += static_cast<long long>(usable);
+    c.peakLiveBytes = std::max(c.peakLiveBytes, c.liveBytes);
+  }
+  /*-- called from operator delete, must not allocate --*/
+  inline void recordFree(size_t usable) {
+    AllocCounters& c = allocCounters;
+    if (c.depth == 0)
+      return;
+    ++c.deallocations;
+    c.liveBytes -= static_cast<long long>(usable);
+  }
+
+  ///////////////////////////////////////////////
+  // AllocScope class
+
+  class AllocScope {
+  public:
+    AllocScope() : start_(allocCounters) {
+      AllocCounters& c = allocCounters;
+      ++c.depth;
+      /* peak is measured relative to live bytes at scope entry */
+      c.peakLiveBytes = c.liveBytes;
+    }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+    ~AllocScope() {
+      AllocCounters& c = allocCounters;
+      --c.depth;
+      c.peakLiveBytes = std::max(start_.peakLiveBytes, c.peakLiveBytes);
+    }
+    /*-- heap use since construction --*/
+    AllocStats stats() const {
+      const AllocCounters& c = allocCounters;
+      AllocStats s;
+      s.allocations = c.allocations - start_.allocations;
+      s.deallocations = c.deallocations - start_.deallocations;
+      s.bytesAllocated = c.bytesAllocated - start_.bytesAllocated;
+      s.peakLiveBytes = c.peakLiveBytes - start_.liveBytes;
+      return s;
+    }
+    /*-- true if no more than n allocations since construction --*/
+    bool atMost(size_t n) const {
+      return stats().allocations <= n;
+    }
+  private:
+    AllocCounters start_;
+  };
+
+  /*-- display stats on one indented line --*/
+  inline void showAllocStats(const AllocStats& s, std::ostream& out = std::cout) {
+    if (!allocTrackingInstalled()) {
+      out << "\n    allocation tracking unavailable, link AllocTracker.cpp";
+      return;
+    }
+    out << "\n    allocations " << s.allocations << ", deallocations " << s.deallocations
+      << ", bytes allocated " << s.bytesAllocated << ", peak live bytes " << s.peakLiveBytes;
+  }
+}
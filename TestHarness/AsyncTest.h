@@ -0,0 +1,194 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// AsyncTest.h - coroutine tests run on an EventLoop       //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Runs tests whose bodies are coroutines:
+   - IAsyncTest, the ITest analogue with Task<bool> test()
+   - AsyncSequencer registers coroutine test classes and
+     functions returning Task<bool>, then doTests(nThreads)
+     starts all of them at once on an EventLoop with nThreads
+     workers, so tests that wait on timers, queues, or I/O
+     overlap instead of holding a thread each
+   - each test gets a TestResult with its name, pass/fail,
+     exception message, and start/end times; cpu time isn't
+     recorded, since a coroutine may run on several threads
+
+   Example:
+     AsyncSequencer seq;
+     seq.reg([]() -> Task<bool> {
+       co_await sleepFor(std::chrono::milliseconds(10));
+       co_return true;
+     }, "sleeps");
+     seq.doTests(2);
+
+   A failed TEST_CO_CHECK stays in the test's own coroutine frames
+   while the test is suspended, see Task.h, and is read from the
+   failure slot as the test returns, so it is charged to the test
+   that made it.
+
+   Results are shown through the reporter of options(), or the
+   default reporter when none is set.  Timeouts, counters, and
+   allocation limits of ExecutorOptions aren't applied to
+   coroutine tests.
+
+   Requires C++20 coroutines.  Compiled with an earlier standard,
+   this header declares nothing.
+
+   Package Dependencies:
+  -----------------------
+   AsyncTest.h
+   Task.h
+   EventLoop.h
+   TestHarness.h
+   TestArena.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.4 - 17 Oct 2026
+   - added options(), so results may go to a chosen reporter
+   ver 1.3 - 17 Oct 2026
+   - failures are kept per test across suspensions
+   ver 1.2 - 17 Oct 2026
+   - a failed TEST_CO_CHECK fails the test and explains why
+   ver 1.1 - 17 Oct 2026
+   - results are buffered in a ReportBatch while tests run
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include "Task.h"
+#include "EventLoop.h"
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include "TestHarness.h"
+#include "TestArena.h"
+
+namespace Test {
+
+  struct IAsyncTest {
+    virtual ~IAsyncTest() {}
+    virtual Task<bool> test() = 0;
+    virtual std::string name() = 0;
+  };
+
+  ///////////////////////////////////////////////
+  // AsyncSequencer class
+
+  class AsyncSequencer {
+  public:
+    using Body = std::function<Task<bool>()>;
+
+    AsyncSequencer() = default;
+    AsyncSequencer(const AsyncSequencer&) = delete;
+    AsyncSequencer& operator=(const AsyncSequencer&) = delete;
+
+    /*-- reporter used to show results --*/
+    void options(const ExecutorOptions& opts) {
+      opts_ = opts;
+    }
+    const ExecutorOptions& options() const {
+      return opts_;
+    }
+    /*-- register function returning Task<bool> --*/
+    void reg(Body body, const std::string& name) {
+      tests_.push_back(Entry{ std::move(body), name });
+    }
+    /*-- construct coroutine test class in the arena --*/
+    template<typename U, typename... Args>
+    U& emplace(Args&&... args) {
+      static_assert(std::is_base_of_v<IAsyncTest, U>, "test class must derive from IAsyncTest");
+      U* pU = arena_.emplace<U>(std::forward<Args>(args)...);
+      tests_.push_back(Entry{ [pU]() { return pU->test(); }, pU->name() });
+      return *pU;
+    }
+    /*---------------------------------------------------
+      start every registered test on an EventLoop with
+      nThreads workers and wait for all to finish
+      - results are displayed in registration order
+    */
+    bool doTests(size_t nThreads = 1) {
+      results_.assign(tests_.size(), TestResult());
+      Countdown done(tests_.size());
+      {
+        EventLoop loop(nThreads);
+        for (size_t i = 0; i < tests_.size(); ++i)
+          drive(loop, tests_[i], results_[i], done);
+        done.wait();
+      }
+      Executor<ITest> ex(opts_);
+      ReportBatch batch(ex.reporter());
+      bool rtn = true;
+      for (auto& r : results_) {
+        ex.showResult(r);
+        rtn &= r.passed;
+      }
+      return rtn;
+    }
+    /*-- result records of most recent run, in registration order --*/
+    const TestResults& results() const {
+      return results_;
+    }
+  private:
+    struct Entry {
+      Body body;
+      std::string name;
+    };
+    struct Countdown {
+      explicit Countdown(size_t n) : remaining(n) {}
+
+      size_t remaining;
+      std::mutex mtx;
+      std::condition_variable cv;
+
+      void arrive() {
+        std::lock_guard<std::mutex> l(mtx);
+        if (--remaining == 0)
+          cv.notify_all();
+      }
+      void wait() {
+        std::unique_lock<std::mutex> l(mtx);
+        cv.wait(l, [this]() { return remaining == 0; });
+      }
+    };
+    /*-- move to a worker, run one test to completion, record it --*/
+    static Detached drive(EventLoop& loop, Entry& test, TestResult& r, Countdown& done) {
+      co_await loop.schedule();
+      r.name = test.name;
+      r.start = Clock::now();
+      clearFailure();
+      try {
+        r.passed = co_await test.body();
+        if (failureRecorded()) {
+          r.passed = false;
+          r.message = describeFailure(failureSlot());
+        }
+      }
+      catch (std::exception& ex) {
+        r.passed = false;
+        r.message = ex.what();
+      }
+      catch (...) {
+        r.passed = false;
+        r.message = "unknown exception";
+      }
+      clearFailure();
+      r.end = Clock::now();
+      done.arrive();
+    }
+
+    TestArena arena_;
+    ExecutorOptions opts_;
+    std::vector<Entry> tests_;
+    TestResults results_;
+  };
+}
+#endif
@@ -0,0 +1,229 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Baseline.h - performance regression gating              //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Keeps benchmark results of a known good build and flags
+   later benchmarks that are slower or allocate more:
+   - time regresses when the median grows by more than
+     threshold and a one-sided Mann-Whitney U test says the
+     new samples are larger with p below alpha, so noise
+     alone rarely fails a test
+   - allocations, bytes, and instructions per iteration vary
+     little from run to run, so they regress on threshold
+     alone, and only if both runs measured them
+   - a test without a baseline record passes and its result
+     becomes the record, so new benchmarks are adopted
+     automatically; update replaces existing records too
+
+   Baseline file format, one test per line:
+     <median ns> <allocations> <bytes> <instructions> <n> <n samples, ns> <test name>
+   allocations, bytes, and instructions are per iteration,
+   -1 if not measured.
+
+   Package Dependencies:
+  -----------------------
+   Baseline.h
+   Benchmark.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include "Benchmark.h"
+
+namespace Test {
+
+  /*-- what the baseline keeps for one benchmark --*/
+  struct BaselineRecord {
+    double median = 0.0;
+    double allocations = -1.0;    // per iteration, -1 if not measured
+    double bytes = -1.0;
+    double instructions = -1.0;
+    std::vector<double> samples;
+  };
+
+  struct RegressionOptions {
+    double threshold = 0.10;    // allowed relative growth
+    double alpha = 0.01;        // significance level for time
+    bool update = false;        // replace existing records with this run
+  };
+
+  /*-- comparison of one benchmark with its baseline --*/
+  struct Regression {
+    std::string name;
+    bool hasBaseline = false;
+    bool regressed = false;
+    double timeChange = 0.0;    // relative, 0.25 means 25% slower
+    double pValue = 1.0;
+    std::string message;
+  };
+
+  /*---------------------------------------------------
+    one-sided Mann-Whitney U test, probability of seeing
+    after ranked this far above before if both came from
+    the same distribution
+    - normal approximation with tie and continuity
+      corrections, fine for the 20 or more samples a
+      benchmark takes
+  */
+  inline double mannWhitneyP(const std::vector<double>& before, const std::vector<double>& after) {
+    size_t n1 = before.size(), n2 = after.size();
+    if (n1 == 0 || n2 == 0)
+      return 1.0;
+    std::vector<std::pair<double, bool>> all;   // value, from after
+    all.reserve(n1 + n2);
+    for (double v : before)
+      all.emplace_back(v, false);
+    for (double v : after)
+      all.emplace_back(v, true);
+    std::sort(all.begin(), all.end());
+
+    double rankSum = 0.0, ties = 0.0;
+    for (size_t i = 0; i < all.size();) {
+      size_t j = i;
+      while (j < all.size() && all[j].first == all[i].first)
+        ++j;
+      double rank = 0.5 * (i + 1 + j);   // mean of ranks i+1 .. j
+      double t = static_cast<double>(j - i);
+      ties += t * t * t - t;
+      for (size_t k = i; k < j; ++k)
+        if (all[k].second)
+          rankSum += rank;
+      i = j;
+    }
+    double a = static_cast<double>(n1), b = static_cast<double>(n2), n = a + b;
+    double u = rankSum - b * (b + 1) / 2.0;
+    double variance = a * b / 12.0 * ((n + 1) - ties / (n * (n - 1)));
+    if (variance <= 0.0)
+      return 1.0;
+    double z = (u - a * b / 2.0 - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+  }
+
+  ///////////////////////////////////////////////
+  // Baseline class
+
+  class Baseline {
+  public:
+    /*-- read baseline file, returns false if file can't be opened --*/
+    bool load(const std::string& path) {
+      std::ifstream in(path);
+      if (!in.good())
+        return false;
+      std::string line;
+      while (std::getline(in, line)) {
+        std::istringstream ln(line);
+        BaselineRecord rec;
+        size_t n = 0;
+        if (!(ln >> rec.median >> rec.allocations >> rec.bytes >> rec.instructions >> n))
+          continue;
+        rec.samples.resize(n);
+        for (double& s : rec.samples)
+          ln >> s;
+        std::string name;
+        ln >> std::ws;
+        std::getline(ln, name);
+        if (ln.fail() || name.empty())
+          continue;
+        records_[name] = std::move(rec);
+      }
+      return true;
+    }
+    /*-- write baseline, replacing file only after a complete write --*/
+    bool save(const std::string& path) const {
+      std::string temp = path + ".tmp";
+      {
+        std::ofstream out(temp);
+        if (!out.good())
+          return false;
+        out.precision(17);
+        for (auto& item : records_) {
+          const BaselineRecord& rec = item.second;
+          out << rec.median << " " << rec.allocations << " " << rec.bytes << " "
+            << rec.instructions << " " << rec.samples.size();
+          for (double s : rec.samples)
+            out << " " << s;
+          out << " " << item.first << "\n";
+        }
+        if (!out.good())
+          return false;
+      }
+      std::remove(path.c_str());
+      return std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+    /*-- make r the record for its test --*/
+    void record(const BenchmarkResult& r) {
+      BaselineRecord& rec = records_[r.name];
+      rec.median = r.median;
+      rec.allocations = r.hasAllocations ? r.allocationsPerIteration : -1.0;
+      rec.bytes = r.hasAllocations ? r.bytesPerIteration : -1.0;
+      rec.instructions = r.hasCounters ? r.instructionsPerIteration : -1.0;
+      rec.samples = r.samples;
+    }
+    /*-- record for name, or nullptr if there is none --*/
+    const BaselineRecord* find(const std::string& name) const {
+      auto iter = records_.find(name);
+      return iter == records_.end() ? nullptr : &iter->second;
+    }
+    /*-- compare a passing benchmark with its record --*/
+    Regression compare(const BenchmarkResult& r, const RegressionOptions& opts = RegressionOptions()) const {
+      Regression g;
+      g.name = r.name;
+      const BaselineRecord* pRec = find(r.name);
+      if (!pRec || !r.passed)
+        return g;
+      g.hasBaseline = true;
+      std::ostringstream why;
+      if (pRec->median > 0.0) {
+        g.timeChange = r.median / pRec->median - 1.0;
+        g.pValue = mannWhitneyP(pRec->samples, r.samples);
+        if (g.timeChange > opts.threshold && g.pValue < opts.alpha) {
+          g.regressed = true;
+          why << "median " << r.median << " ns vs baseline " << pRec->median << " ns, "
+            << percent(g.timeChange) << ", p = " << g.pValue;
+        }
+      }
+      auto grew = [&](const char* what, double now, double was) {
+        if (now <= was * (1.0 + opts.threshold) + 0.5)
+          return;
+        if (g.regressed)
+          why << "; ";
+        g.regressed = true;
+        why << what << " " << now << " vs baseline " << was << " per iteration";
+      };
+      if (r.hasAllocations && pRec->allocations >= 0.0)
+        grew("allocations", r.allocationsPerIteration, pRec->allocations);
+      if (r.hasAllocations && pRec->bytes >= 0.0)
+        grew("bytes", r.bytesPerIteration, pRec->bytes);
+      if (r.hasCounters && pRec->instructions >= 0.0)
+        grew("instructions", r.instructionsPerIteration, pRec->instructions);
+      g.message = why.str();
+      return g;
+    }
+    size_t size() const {
+      return records_.size();
+    }
+  private:
+    static std::string percent(double change) {
+      std::ostringstream out;
+      out.precision(3);
+      out << (change >= 0.0 ? "+" : "") << change * 100.0 << "%";
+      return out.str();
+    }
+    std::map<std::string, BaselineRecord> records_;
+  };
+}
@@ -0,0 +1,242 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Benchmark.h - statistical timing of test callables      //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Times a bool() callable many times and summarizes the samples:
+   - runs warm-up iterations before any timing
+   - doubles the iteration count of each sample until one
+     sample lasts at least minSampleTime
+   - rejects samples further than outlierCutoff scaled median
+     absolute deviations from the median
+   - reports median, MAD, min, and a distribution-free
+     confidence interval for the median, all in nanoseconds
+     per iteration
+   - optionally counts heap allocations and, where available,
+     instructions and cycles per iteration over the timed samples
+
+   Package Dependencies:
+  -----------------------
+   Benchmark.h
+   TestClock.h
+   AllocTracker.h, PerfCounters.h (optional measurements)
+   Reporter.h
+   TestAssertions.h (failure slot)
+
+   Maintenance History:
+  ----------------------
+   ver 1.3 - 17 Oct 2026
+   - each call runs in its own failure scope, so a failed check
+     is reported here and never charged to the caller's test
+   ver 1.2 - 17 Oct 2026
+   - summaries may be shown through a Reporter
+   ver 1.1 - 17 Oct 2026
+   - added allocation and event counts per iteration
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <optional>
+#include "TestClock.h"
+#include "AllocTracker.h"
+#include "PerfCounters.h"
+#include "Reporter.h"
+#include "../TestUtilities/TestAssertions.h"
+
+namespace Test {
+
+  struct BenchmarkOptions {
+    size_t warmupIterations = 10;
+    Nanoseconds minSampleTime = std::chrono::milliseconds(1);
+    size_t samples = 30;
+    double outlierCutoff = 3.0;
+    double z = 1.96;            // 95% confidence
+    bool allocations = false;   // needs AllocTracker.cpp linked
+    bool counters = false;
+  };
+
+  /*-- summary of one benchmark, times are ns per iteration --*/
+  struct BenchmarkResult {
+    std::string name;
+    bool passed = true;
+    std::string message;
+    size_t iterations = 0;
+    size_t outliers = 0;
+    std::vector<double> samples;
+    double median = 0.0;
+    double mad = 0.0;
+    double min = 0.0;
+    double ciLow = 0.0;
+    double ciHigh = 0.0;
+    bool hasAllocations = false;
+    double allocationsPerIteration = 0.0;
+    double bytesPerIteration = 0.0;
+    bool hasCounters = false;
+    double instructionsPerIteration = 0.0;
+    double cyclesPerIteration = 0.0;
+  };
+
+  /*-- median of values, sorts its argument --*/
+  inline double median(std::vector<double>& values) {
+    if (values.empty())
+      return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return (n % 2 == 1) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+  }
+  /*-- median absolute deviation from med --*/
+  inline double medianAbsDeviation(const std::vector<double>& values, double med) {
+    std::vector<double> devs;
+    devs.reserve(values.size());
+    for (double v : values)
+      devs.push_back(std::fabs(v - med));
+    return median(devs);
+  }
+
+  /*---------------------------------------------------
+    fill in median, MAD, min, and confidence interval
+    - samples outside the MAD fence are moved out of
+      r.samples and counted as outliers
+    - interval bounds are order statistics, so make no
+      assumption about the shape of the distribution
+  */
+  inline void summarize(BenchmarkResult& r, const BenchmarkOptions& opts) {
+    std::vector<double>& s = r.samples;
+    if (s.empty())
+      return;
+    double med = median(s);
+    double mad = medianAbsDeviation(s, med);
+    if (mad > 0.0) {
+      double fence = opts.outlierCutoff * 1.4826 * mad;
+      auto keep = std::remove_if(s.begin(), s.end(),
+        [=](double v) { return std::fabs(v - med) > fence; }
+      );
+      r.outliers = static_cast<size_t>(s.end() - keep);
+      s.erase(keep, s.end());
+    }
+    r.median = median(s);
+    r.mad = medianAbsDeviation(s, r.median);
+    r.min = s.front();
+
+    double n = static_cast<double>(s.size());
+    double half = opts.z * std::sqrt(n) / 2.0;
+    long lo = static_cast<long>(std::floor(n / 2.0 - half));
+    long hi = static_cast<long>(std::ceil(n / 2.0 + half));
+    lo = std::max(lo, 0L);
+    hi = std::min(hi, static_cast<long>(s.size()) - 1);
+    r.ciLow = s[lo];
+    r.ciHigh = s[hi];
+  }
+
+  /*---------------------------------------------------
+    benchmark callable f returning bool
+    - a false return, a failed check, or an exception stops
+      the run and marks the result failed
+  */
+  template<typename F>
+  BenchmarkResult benchmark(F&& f, const std::string& name, const BenchmarkOptions& opts = BenchmarkOptions()) {
+    BenchmarkResult r;
+    r.name = name;
+    auto runBatch = [&](size_t n) {
+      for (size_t i = 0; i < n; ++i) {
+        FailureScope failure;
+        bool ok = f();
+        if (!ok || failure.failed()) {
+          r.passed = false;
+          r.message = failure.failed() ? failure.message() : "test returned false";
+          return;
+        }
+      }
+    };
+    try {
+      runBatch(opts.warmupIterations);
+
+      size_t iterations = 1;
+      while (r.passed) {
+        auto start = Clock::now();
+        runBatch(iterations);
+        if (Clock::now() - start >= opts.minSampleTime)
+          break;
+        iterations *= 2;
+      }
+      r.iterations = iterations;
+
+      r.samples.reserve(opts.samples);
+      std::optional<AllocScope> allocScope;
+      if (opts.allocations)
+        allocScope.emplace();
+      PerfGroup* pCounters = opts.counters ? &PerfGroup::forThisThread() : nullptr;
+      if (pCounters)
+        pCounters->start();
+      for (size_t i = 0; i < opts.samples && r.passed; ++i) {
+        auto start = Clock::now();
+        runBatch(iterations);
+        Nanoseconds elapsed = Clock::now() - start;
+        r.samples.push_back(static_cast<double>(elapsed.count()) / iterations);
+      }
+      double timed = static_cast<double>(r.samples.size() * iterations);
+      if (pCounters) {
+        PerfCounts c = pCounters->stop();
+        r.hasCounters = c.hardware && timed > 0.0;
+        if (r.hasCounters) {
+          r.instructionsPerIteration = c.instructions / timed;
+          r.cyclesPerIteration = c.cycles / timed;
+        }
+      }
+      r.hasAllocations = allocScope && allocTrackingInstalled() && timed > 0.0;
+      if (r.hasAllocations) {
+        AllocStats a = allocScope->stats();
+        r.allocationsPerIteration = a.allocations / timed;
+        r.bytesPerIteration = a.bytesAllocated / timed;
+      }
+    }
+    catch (std::exception& ex) {
+      r.passed = false;
+      r.message = ex.what();
+    }
+    catch (...) {
+      r.passed = false;
+      r.message = "unknown exception";
+    }
+    if (r.passed)
+      summarize(r, opts);
+    else
+      r.samples.clear();
+    return r;
+  }
+
+  /*-- display benchmark summary --*/
+  inline void showBenchmark(const BenchmarkResult& r, std::ostream& out) {
+    out << "\n  " << r.name;
+    if (!r.passed) {
+      out << " failed : " << r.message;
+      return;
+    }
+    out << " : median " << r.median << " ns, MAD " << r.mad
+      << " ns, min " << r.min << " ns, CI [" << r.ciLow << ", " << r.ciHigh << "] ns"
+      << "\n    " << r.samples.size() << " samples of " << r.iterations
+      << " iterations, " << r.outliers << " outliers rejected";
+    if (r.hasAllocations)
+      out << "\n    " << r.allocationsPerIteration << " allocations, "
+        << r.bytesPerIteration << " bytes per iteration";
+    if (r.hasCounters)
+      out << "\n    " << r.instructionsPerIteration << " instructions, "
+        << r.cyclesPerIteration << " cycles per iteration";
+  }
+  /*-- report benchmark summary as one note --*/
+  inline void showBenchmark(const BenchmarkResult& r, Reporter& reporter = defaultReporter()) {
+    std::ostringstream out;
+    showBenchmark(r, out);
+    noteLines(reporter, out.str());
+  }
+}
@@ -0,0 +1,423 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// EventLoop.h - resumes suspended coroutines on workers   //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Runs many coroutines on a few threads:
+   - worker threads resume coroutines from a shared ready queue
+   - one poller thread waits for the earliest timer and, on
+     Linux, for file descriptors through epoll, then moves the
+     coroutines waiting on them to the ready queue
+   - coroutines co_await:
+       sleepFor(d), sleepUntil(t)    timers
+       readable(fd), writable(fd)    epoll readiness, Linux only
+       blocking(f)                   f run on a small helper pool,
+                                     e.g., BlockingQueue::deQ()
+       AsyncQueue<T>::pop()          suspends until an item arrives
+   - EventLoop::current() is the loop running the calling worker
+
+   A suspended coroutine costs only its frame, so thousands of
+   tests waiting on timers or queues need no thread each.  Regular
+   files are always ready, so epoll can't wait on them; read them
+   with blocking().
+
+   Requires C++20 coroutines.  Compiled with an earlier standard,
+   this header declares nothing.
+
+   Package Dependencies:
+  -----------------------
+   EventLoop.h
+   Task.h
+   TestClock.h
+   ThreadPool.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include "Task.h"
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include "TestClock.h"
+#include "ThreadPool.h"
+
+#ifdef __linux__
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // EventLoop class
+
+  class EventLoop {
+  public:
+    explicit EventLoop(size_t nThreads = 1, size_t blockingThreads = 4)
+      : blockingThreads_(blockingThreads == 0 ? 1 : blockingThreads) {
+#ifdef __linux__
+      epfd_ = epoll_create1(EPOLL_CLOEXEC);
+      wakefd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if (epfd_ < 0 || wakefd_ < 0)
+        throw std::system_error(errno, std::generic_category(), "EventLoop");
+      epoll_event ev{};
+      ev.events = EPOLLIN;
+      ev.data.ptr = nullptr;
+      epoll_ctl(epfd_, EPOLL_CTL_ADD, wakefd_, &ev);
+#endif
+      if (nThreads == 0)
+        nThreads = 1;
+      poller_ = std::thread(&EventLoop::pollerProc, this);
+      for (size_t i = 0; i < nThreads; ++i)
+        workers_.emplace_back(&EventLoop::workerProc, this);
+    }
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /*-- coroutines still suspended are abandoned, not resumed --*/
+    ~EventLoop() {
+      {
+        std::lock_guard<std::mutex> l(timerMtx_);
+        stopPoller_ = true;
+      }
+      wakePoller();
+      poller_.join();
+      {
+        std::lock_guard<std::mutex> l(readyMtx_);
+        stopWorkers_ = true;
+      }
+      readyCv_.notify_all();
+      for (auto& w : workers_)
+        w.join();
+      pBlocking_.reset();
+#ifdef __linux__
+      close(wakefd_);
+      close(epfd_);
+#endif
+    }
+    /*-- loop running the calling worker thread --*/
+    static EventLoop& current() {
+      if (!pCurrent_)
+        throw std::logic_error("not running on an EventLoop worker");
+      return *pCurrent_;
+    }
+    /*-- queue coroutine for resumption on a worker --*/
+    void post(std::coroutine_handle<> h) {
+      {
+        std::lock_guard<std::mutex> l(readyMtx_);
+        ready_.push_back(h);
+      }
+      readyCv_.notify_one();
+    }
+
+    struct Schedule {
+      EventLoop& loop;
+      bool await_ready() noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h) { loop.post(h); }
+      void await_resume() noexcept {}
+    };
+    /*-- continue the awaiting coroutine on one of this loop's workers --*/
+    Schedule schedule() {
+      return Schedule{ *this };
+    }
+
+    struct Sleep {
+      EventLoop& loop;
+      Clock::time_point deadline;
+      bool await_ready() const { return Clock::now() >= deadline; }
+      void await_suspend(std::coroutine_handle<> h) { loop.addTimer(deadline, h); }
+      void await_resume() noexcept {}
+    };
+    Sleep sleepUntil(Clock::time_point deadline) {
+      return Sleep{ *this, deadline };
+    }
+    template<typename Rep, typename Period>
+    Sleep sleepFor(std::chrono::duration<Rep, Period> d) {
+      return Sleep{ *this, Clock::now() + std::chrono::duration_cast<Clock::duration>(d) };
+    }
+
+#ifdef __linux__
+    struct FdWait {
+      EventLoop& loop;
+      int fd;
+      uint32_t events;
+      std::coroutine_handle<> h;
+      bool await_ready() noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> handle) {
+        h = handle;
+        epoll_event ev{};
+        ev.events = events | EPOLLONESHOT;
+        ev.data.ptr = this;
+        if (epoll_ctl(loop.epfd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+          throw std::system_error(errno, std::generic_category(), "epoll_ctl");
+      }
+      void await_resume() noexcept {}
+    };
+    /*-- one waiter per descriptor and direction at a time --*/
+    FdWait readable(int fd) {
+      return FdWait{ *this, fd, EPOLLIN, nullptr };
+    }
+    FdWait writable(int fd) {
+      return FdWait{ *this, fd, EPOLLOUT, nullptr };
+    }
+#endif
+
+    template<typename F>
+    struct BlockingCall {
+      using R = std::invoke_result_t<F&>;
+      using Slot = std::conditional_t<std::is_void_v<R>, bool, std::optional<R>>;
+
+      BlockingCall(EventLoop& l, F fn) : loop(l), f(std::move(fn)) {}
+
+      EventLoop& loop;
+      F f;
+      Slot value{};
+      std::exception_ptr error;
+
+      bool await_ready() noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h) {
+        loop.blockingPool().submit([this, h]() {
+          try {
+            if constexpr (std::is_void_v<R>)
+              f();
+            else
+              value.emplace(f());
+          }
+          catch (...) {
+            error = std::current_exception();
+          }
+          loop.post(h);
+        });
+      }
+      R await_resume() {
+        if (error)
+          std::rethrow_exception(error);
+        if constexpr (!std::is_void_v<R>)
+          return std::move(*value);
+      }
+    };
+    /*-- run blocking call f off the workers, resuming with its result --*/
+    template<typename F>
+    BlockingCall<std::decay_t<F>> blocking(F&& f) {
+      return BlockingCall<std::decay_t<F>>(*this, std::forward<F>(f));
+    }
+  private:
+    struct Timer {
+      Clock::time_point deadline;
+      uint64_t seq;
+      std::coroutine_handle<> h;
+      bool operator>(const Timer& t) const {
+        if (deadline != t.deadline)
+          return deadline > t.deadline;
+        return seq > t.seq;
+      }
+    };
+    void addTimer(Clock::time_point deadline, std::coroutine_handle<> h) {
+      bool earliest;
+      {
+        std::lock_guard<std::mutex> l(timerMtx_);
+        earliest = timers_.empty() || deadline < timers_.top().deadline;
+        timers_.push(Timer{ deadline, timerSeq_++, h });
+      }
+      if (earliest)
+        wakePoller();
+    }
+    ThreadPool& blockingPool() {
+      std::call_once(blockingOnce_, [this]() {
+        pBlocking_ = std::make_unique<ThreadPool>(blockingThreads_);
+      });
+      return *pBlocking_;
+    }
+    void wakePoller() {
+#ifdef __linux__
+      uint64_t one = 1;
+      ssize_t rc = write(wakefd_, &one, sizeof(one));
+      (void)rc;
+#else
+      pollCv_.notify_one();
+#endif
+    }
+    /*-- fire expired timers, then wait for the next timer or event --*/
+    void pollerProc() {
+      std::unique_lock<std::mutex> l(timerMtx_);
+      while (!stopPoller_) {
+        Clock::time_point now = Clock::now();
+        while (!timers_.empty() && timers_.top().deadline <= now) {
+          post(timers_.top().h);
+          timers_.pop();
+        }
+        Clock::time_point next = timers_.empty() ? Clock::time_point::max() : timers_.top().deadline;
+#ifdef __linux__
+        l.unlock();
+        waitEvents(next);
+        l.lock();
+#else
+        if (next == Clock::time_point::max())
+          pollCv_.wait(l);
+        else
+          pollCv_.wait_until(l, next);
+#endif
+      }
+    }
+#ifdef __linux__
+    void waitEvents(Clock::time_point next) {
+      int timeoutMs = -1;
+      if (next != Clock::time_point::max()) {
+        auto wait = next - Clock::now();
+        auto ms = std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+        timeoutMs = static_cast<int>(std::clamp<long long>(ms, 0, INT_MAX));
+      }
+      epoll_event events[64];
+      int n = epoll_wait(epfd_, events, 64, timeoutMs);
+      for (int i = 0; i < n; ++i) {
+        if (events[i].data.ptr == nullptr) {
+          uint64_t count;
+          ssize_t rc = read(wakefd_, &count, sizeof(count));
+          (void)rc;
+          continue;
+        }
+        FdWait* pWait = static_cast<FdWait*>(events[i].data.ptr);
+        std::coroutine_handle<> h = pWait->h;
+        epoll_ctl(epfd_, EPOLL_CTL_DEL, pWait->fd, nullptr);
+        post(h);
+      }
+    }
+#endif
+    void workerProc() {
+      pCurrent_ = this;
+      std::unique_lock<std::mutex> l(readyMtx_);
+      while (true) {
+        readyCv_.wait(l, [this]() { return stopWorkers_ || !ready_.empty(); });
+        if (ready_.empty())
+          break;
+        std::coroutine_handle<> h = ready_.front();
+        ready_.pop_front();
+        l.unlock();
+        h.resume();
+        l.lock();
+      }
+      pCurrent_ = nullptr;
+    }
+
+    inline static thread_local EventLoop* pCurrent_ = nullptr;
+
+    std::mutex readyMtx_;
+    std::condition_variable readyCv_;
+    std::deque<std::coroutine_handle<>> ready_;
+    bool stopWorkers_ = false;
+
+    std::mutex timerMtx_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    uint64_t timerSeq_ = 0;
+    bool stopPoller_ = false;
+#ifdef __linux__
+    int epfd_ = -1;
+    int wakefd_ = -1;
+#else
+    std::condition_variable pollCv_;
+#endif
+
+    size_t blockingThreads_;
+    std::once_flag blockingOnce_;
+    std::unique_ptr<ThreadPool> pBlocking_;
+    std::thread poller_;
+    std::vector<std::thread> workers_;
+  };
+
+  /*-- awaitables on the current loop, for use in test bodies --*/
+  template<typename Rep, typename Period>
+  EventLoop::Sleep sleepFor(std::chrono::duration<Rep, Period> d) {
+    return EventLoop::current().sleepFor(d);
+  }
+  inline EventLoop::Sleep sleepUntil(Clock::time_point deadline) {
+    return EventLoop::current().sleepUntil(deadline);
+  }
+  template<typename F>
+  auto blocking(F&& f) {
+    return EventLoop::current().blocking(std::forward<F>(f));
+  }
+
+  ///////////////////////////////////////////////
+  // AsyncQueue class
+
+  template<typename T>
+  class AsyncQueue {
+  public:
+    /*-- hand item to the oldest waiter, or queue it --*/
+    void push(T t) {
+      std::unique_lock<std::mutex> l(mtx_);
+      if (waiters_.empty()) {
+        items_.push_back(std::move(t));
+        return;
+      }
+      Pop* pWaiter = waiters_.front();
+      waiters_.pop_front();
+      pWaiter->value.emplace(std::move(t));
+      EventLoop* pLoop = pWaiter->pLoop;
+      std::coroutine_handle<> h = pWaiter->h;
+      l.unlock();
+      pLoop->post(h);
+    }
+
+    struct Pop {
+      explicit Pop(AsyncQueue& queue) : q(queue) {}
+
+      AsyncQueue& q;
+      std::optional<T> value;
+      EventLoop* pLoop = nullptr;
+      std::coroutine_handle<> h;
+
+      bool await_ready() noexcept { return false; }
+      bool await_suspend(std::coroutine_handle<> handle) {
+        std::lock_guard<std::mutex> l(q.mtx_);
+        if (!q.items_.empty()) {
+          value.emplace(std::move(q.items_.front()));
+          q.items_.pop_front();
+          return false;
+        }
+        h = handle;
+        pLoop = &EventLoop::current();
+        q.waiters_.push_back(this);
+        return true;
+      }
+      T await_resume() {
+        return std::move(*value);
+      }
+    };
+    /*-- co_await pop() to take the next item --*/
+    Pop pop() {
+      return Pop(*this);
+    }
+    size_t size() {
+      std::lock_guard<std::mutex> l(mtx_);
+      return items_.size();
+    }
+  private:
+    std::mutex mtx_;
+    std::deque<T> items_;
+    std::deque<Pop*> waiters_;
+  };
+}
+#endif
@@ -0,0 +1,256 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// FixtureCache.h - shared, lazily constructed fixtures    //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Lets tests share expensive setup:
+   - declareFixture<F>(name, factory, scope) registers how to
+     build fixture F, nothing is built yet
+   - usingFixtures(names, body) wraps a test body, declaring that
+     it uses the named fixtures
+   - fixture<F>(name), called in a test body, builds the fixture
+     on first use, once per process or once per worker thread,
+     and returns a FixtureRef sharing it read-only
+   - FixtureRef::mutate() gives the test a private copy, made on
+     its first write, so tests never see each other's changes
+   - when every declared user has finished, the fixture is
+     destroyed, as soon as the last FixtureRef to it goes away
+   - a user finishes once per planned run: while a FixtureRun is
+     open, e.g., for all iterations of a benchmark or all threads
+     of a stress run, calls only note the user, and it finishes
+     when the run closes
+
+   Example:
+     declareFixture<Dataset>("dataset", []() { return loadDataset(); });
+     sequencer.reg(usingFixtures({ "dataset" }, []() {
+       return fixture<Dataset>("dataset")->size() > 0;
+     }), "datasetNotEmpty");
+
+   A declared user that never runs, e.g., a test outside this
+   shard, keeps its fixtures alive until the process exits.
+
+   Package Dependencies:
+  -----------------------
+   FixtureCache.h
+   TestCallable.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.1 - 17 Oct 2026
+   - added FixtureRun, uses are counted per planned run
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <map>
+#include <typeindex>
+#include <stdexcept>
+#include "TestCallable.h"
+
+namespace Test {
+
+  enum class FixtureScope { process, worker };
+
+  ///////////////////////////////////////////////
+  // FixtureRef class - shared read, private write
+
+  template<typename F>
+  class FixtureRef {
+  public:
+    explicit FixtureRef(std::shared_ptr<const F> pShared) : pShared_(std::move(pShared)) {}
+
+    const F& operator*() const { return pCopy_ ? *pCopy_ : *pShared_; }
+    const F* operator->() const { return &**this; }
+
+    /*-- copy on first write, later writes use the copy --*/
+    F& mutate() {
+      if (!pCopy_)
+        pCopy_ = std::make_unique<F>(*pShared_);
+      return *pCopy_;
+    }
+  private:
+    std::shared_ptr<const F> pShared_;
+    std::unique_ptr<F> pCopy_;
+  };
+
+  ///////////////////////////////////////////////
+  // FixtureCache class
+
+  class FixtureCache {
+  public:
+    static FixtureCache& instance() {
+      static FixtureCache cache;
+      return cache;
+    }
+    /*-- register factory, replacing any earlier declaration --*/
+    template<typename F, typename Factory>
+    void declare(const std::string& name, Factory factory, FixtureScope scope) {
+      auto pEntry = std::make_shared<Entry>();
+      pEntry->type = std::type_index(typeid(F));
+      pEntry->scope = scope;
+      pEntry->factory = [factory]() mutable -> std::shared_ptr<const void> {
+        return std::shared_ptr<const F>(std::make_shared<F>(factory()));
+      };
+      std::lock_guard<std::mutex> l(mtx_);
+      entries_[name] = pEntry;
+    }
+    /*-- one more test will use fixture --*/
+    void use(const std::string& name) {
+      std::shared_ptr<Entry> pEntry = find(name);
+      std::lock_guard<std::mutex> l(pEntry->mtx);
+      ++pEntry->users;
+    }
+    /*-- a user finished, tear down after the last one --*/
+    void finished(const std::string& name) {
+      std::shared_ptr<Entry> pEntry = find(name);
+      std::map<std::thread::id, std::shared_ptr<const void>> doomed;
+      {
+        std::lock_guard<std::mutex> l(pEntry->mtx);
+        if (++pEntry->finished < pEntry->users)
+          return;
+        doomed.swap(pEntry->instances);
+        pEntry->finished = 0;
+      }
+      /* destroyed here, outside the lock, unless a FixtureRef still shares it */
+    }
+    /*-- build on first use, then share --*/
+    template<typename F>
+    FixtureRef<F> acquire(const std::string& name) {
+      std::shared_ptr<Entry> pEntry = find(name);
+      if (pEntry->type != std::type_index(typeid(F)))
+        throw std::logic_error("fixture " + name + " requested with wrong type");
+      std::thread::id key;
+      if (pEntry->scope == FixtureScope::worker)
+        key = std::this_thread::get_id();
+
+      std::lock_guard<std::mutex> l(pEntry->mtx);
+      std::shared_ptr<const void>& pInstance = pEntry->instances[key];
+      if (!pInstance)
+        pInstance = pEntry->factory();
+      return FixtureRef<F>(std::static_pointer_cast<const F>(pInstance));
+    }
+    /*-- true if fixture is currently built for some scope --*/
+    bool isBuilt(const std::string& name) {
+      std::shared_ptr<Entry> pEntry = find(name);
+      std::lock_guard<std::mutex> l(pEntry->mtx);
+      return !pEntry->instances.empty();
+    }
+  private:
+    struct Entry {
+      std::type_index type = std::type_index(typeid(void));
+      FixtureScope scope = FixtureScope::process;
+      std::function<std::shared_ptr<const void>()> factory;
+      /* construction holds mtx, so each fixture is built once */
+      std::mutex mtx;
+      std::map<std::thread::id, std::shared_ptr<const void>> instances;
+      size_t users = 0;
+      size_t finished = 0;
+    };
+    std::shared_ptr<Entry> find(const std::string& name) {
+      std::lock_guard<std::mutex> l(mtx_);
+      auto iter = entries_.find(name);
+      if (iter == entries_.end())
+        throw std::logic_error("fixture " + name + " was not declared");
+      return iter->second;
+    }
+    std::mutex mtx_;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+  };
+
+  ///////////////////////////////////////////////
+  // FixtureRun class - one planned run of tests
+
+  class FixtureRun {
+  public:
+    FixtureRun() : pOuter_(current()) {
+      current() = this;
+    }
+    FixtureRun(const FixtureRun&) = delete;
+    FixtureRun& operator=(const FixtureRun&) = delete;
+    /*-- each user called during the run finishes once --*/
+    ~FixtureRun() {
+      current() = pOuter_;
+      for (auto& pNames : users_)
+        for (auto& name : *pNames)
+          FixtureCache::instance().finished(name);
+    }
+    /*-- run open on calling thread, if any --*/
+    static FixtureRun* active() {
+      return current();
+    }
+    /*-- user, identified by its names, finishes when run closes --*/
+    void defer(const std::shared_ptr<const std::vector<std::string>>& pNames) {
+      std::lock_guard<std::mutex> l(mtx_);
+      for (auto& pUser : users_)
+        if (pUser == pNames)
+          return;
+      users_.push_back(pNames);
+    }
+    /*-- makes pRun the open run on this thread, e.g., a stress worker, while alive --*/
+    class Attach {
+    public:
+      explicit Attach(FixtureRun* pRun) : pOuter_(current()) {
+        current() = pRun;
+      }
+      Attach(const Attach&) = delete;
+      Attach& operator=(const Attach&) = delete;
+      ~Attach() {
+        current() = pOuter_;
+      }
+    private:
+      FixtureRun* pOuter_;
+    };
+  private:
+    static FixtureRun*& current() {
+      thread_local FixtureRun* pRun = nullptr;
+      return pRun;
+    }
+    FixtureRun* pOuter_;
+    std::mutex mtx_;
+    std::vector<std::shared_ptr<const std::vector<std::string>>> users_;
+  };
+
+  /*-- register how to build fixture F --*/
+  template<typename F, typename Factory>
+  void declareFixture(const std::string& name, Factory factory, FixtureScope scope = FixtureScope::process) {
+    FixtureCache::instance().declare<F>(name, std::move(factory), scope);
+  }
+
+  /*-- shared, read-only view of fixture, built on first use --*/
+  template<typename F>
+  FixtureRef<F> fixture(const std::string& name) {
+    return FixtureCache::instance().acquire<F>(name);
+  }
+
+  /*-- wrap test body, declaring the fixtures it uses --*/
+  template<typename Body>
+  TestCallable usingFixtures(std::vector<std::string> names, Body body) {
+    for (auto& name : names)
+      FixtureCache::instance().use(name);
+    auto pNames = std::make_shared<const std::vector<std::string>>(std::move(names));
+    return [pNames = std::move(pNames), body = std::move(body)]() mutable {
+      struct Finish {
+        const std::shared_ptr<const std::vector<std::string>>& pNames;
+        ~Finish() {
+          if (FixtureRun* pRun = FixtureRun::active()) {
+            pRun->defer(pNames);
+            return;
+          }
+          for (auto& name : *pNames)
+            FixtureCache::instance().finished(name);
+        }
+      } finish{ pNames };
+      return body();
+    };
+  }
+}
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////
+// FuzzCoverage.cpp - edge counters fed by sanitizer coverage  //
+//                                                             //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ     //
+/////////////////////////////////////////////////////////////////
+/*
+   Link this file to let Fuzzer.h see which edges an input
+   reaches.  It implements the callbacks that compilers insert
+   into code built with sanitizer coverage:
+     clang     -fsanitize-coverage=trace-pc-guard
+               -fsanitize-coverage=inline-8bit-counters
+     gcc       -fsanitize-coverage=trace-pc
+     MSVC      /fsanitize-coverage=edge (inline 8 bit counters)
+   Compile only the code under test with those options, never
+   this file or the harness, so counters describe the target.
+
+   Callbacks run before main, during static initialization, so
+   the counter tables are plain zero initialized arrays.
+*/
+
+#include "Fuzzer.h"
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+  constexpr size_t maxCounters = 1 << 16;
+  constexpr size_t maxRegions = 256;
+
+  /* guard and trace-pc counters, index 0 unused */
+  unsigned char counters[maxCounters];
+  uint32_t nextGuard = 0;
+  bool tracePcSeen = false;
+
+  /* inline 8 bit counter regions, one per instrumented module */
+  struct Region {
+    unsigned char* begin;
+    unsigned char* end;
+  };
+  Region regions[maxRegions];
+  size_t nRegions = 0;
+
+  /* bit b of seen[i] set once counter i reached hit count bucket b */
+  std::vector<unsigned char> seenCounters;
+  std::vector<std::vector<unsigned char>> seenRegions;
+  size_t nFeatures = 0;
+
+  inline unsigned bucket(unsigned char hits) {
+    if (hits >= 128) return 7;
+    if (hits >= 32) return 6;
+    if (hits >= 16) return 5;
+    if (hits >= 8) return 4;
+    if (hits >= 4) return 3;
+    return hits - 1;
+  }
+  /* count, and if keep mark, features of counters, then zero them */
+  size_t scan(unsigned char* pCounters, size_t n, std::vector<unsigned char>& seen, bool keep) {
+    if (seen.size() < n)
+      seen.resize(n, 0);
+    size_t found = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (pCounters[i] == 0)
+        continue;
+      unsigned char bit = static_cast<unsigned char>(1u << bucket(pCounters[i]));
+      if (!(seen[i] & bit)) {
+        ++found;
+        if (keep)
+          seen[i] |= bit;
+      }
+      pCounters[i] = 0;
+    }
+    return found;
+  }
+  size_t usedCounters() {
+    if (tracePcSeen)
+      return maxCounters;
+    if (nextGuard == 0)
+      return 0;
+    return std::min<size_t>(static_cast<size_t>(nextGuard) + 1, maxCounters);   // guards wrap past maxCounters
+  }
+}
+
+extern "C" {
+
+  void __sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop) {
+    if (start == stop || *start != 0)
+      return;
+    for (uint32_t* guard = start; guard < stop; ++guard)
+      *guard = (nextGuard++ % (maxCounters - 1)) + 1;
+  }
+
+  void __sanitizer_cov_trace_pc_guard(uint32_t* guard) {
+    unsigned char& c = counters[*guard];
+    if (c != 255)
+      ++c;
+  }
+
+  void __sanitizer_cov_8bit_counters_init(char* start, char* end) {
+    if (nRegions < maxRegions && start < end)
+      regions[nRegions++] = Region{
+        reinterpret_cast<unsigned char*>(start), reinterpret_cast<unsigned char*>(end)
+      };
+  }
+
+#if defined(__GNUC__)
+  /* gcc only offers trace-pc, so return addresses are hashed into counters */
+  void __sanitizer_cov_trace_pc() {
+    uintptr_t pc = reinterpret_cast<uintptr_t>(__builtin_return_address(0));
+    pc ^= pc >> 17;
+    pc *= 0x9E3779B97F4A7C15ULL;
+    unsigned char& c = counters[(pc >> 40) % (maxCounters - 1) + 1];
+    if (c != 255)
+      ++c;
+    tracePcSeen = true;
+  }
+#endif
+}
+
+namespace Test {
+  namespace coverage {
+
+    bool instrumented() {
+      return usedCounters() > 0 || nRegions > 0;
+    }
+
+    void clear() {
+      std::memset(counters, 0, usedCounters());
+      for (size_t r = 0; r < nRegions; ++r)
+        std::memset(regions[r].begin, 0, regions[r].end - regions[r].begin);
+    }
+
+    size_t newFeatures(bool keep) {
+      size_t found = scan(counters, usedCounters(), seenCounters, keep);
+      if (seenRegions.size() < nRegions)
+        seenRegions.resize(nRegions);
+      for (size_t r = 0; r < nRegions; ++r)
+        found += scan(regions[r].begin, regions[r].end - regions[r].begin, seenRegions[r], keep);
+      if (keep)
+        nFeatures += found;
+      return found;
+    }
+
+    size_t features() {
+      return nFeatures;
+    }
+  }
+}
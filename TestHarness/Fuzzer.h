@@ -0,0 +1,345 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Fuzzer.h - in-process coverage guided fuzzing           //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Fuzzes a target, bool target(const uint8_t* data, size_t size),
+   in a loop inside the test process:
+   - inputs are mutated copies of corpus entries, written into
+     one reused buffer
+   - after each run the edge counters from FuzzCoverage.cpp are
+     compared with everything seen so far, and inputs reaching
+     new edges, or known edges a new number of times, join the
+     corpus, saved in opts.corpusDir if one is given
+   - a target fails by returning false or letting an exception
+     escape; the failing input is minimized by removing chunks
+     while it still fails the same way, then written to
+     opts.crashDir
+   - if the target crashes the process, a signal handler writes
+     the input that was running to crashDir, best effort
+
+   Without coverage instrumentation the corpus never grows, and
+   fuzzing degrades to random mutation of the seed inputs.
+
+   Example:
+     bool parseDate(const uint8_t* data, size_t size) {
+       try {
+         Utilities::DateTime dt(std::string(data, data + size));
+       }
+       catch (std::exception&) {}    // rejecting bad input is fine
+       return true;
+     }
+     showFuzz(fuzz(parseDate, opts));
+
+   Package Dependencies:
+  -----------------------
+   Fuzzer.h, FuzzCoverage.cpp
+   TestClock.h
+   PropertyTest.h (Rng)
+   Sharding.h (stableHash)
+   Reporter.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.2 - 17 Oct 2026
+   - signal handlers in place before fuzz() are restored after
+     it, and run after the crash input is saved
+   ver 1.1 - 17 Oct 2026
+   - results are shown through a Reporter
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <exception>
+#include <csignal>
+#include <cstdio>
+#include <cstdint>
+#include <iterator>
+#include "TestClock.h"
+#include "PropertyTest.h"
+#include "Sharding.h"
+#include "Reporter.h"
+
+namespace Test {
+
+  /*-- edge feedback, defined in FuzzCoverage.cpp --*/
+  namespace coverage {
+    bool instrumented();
+    void clear();
+    size_t newFeatures(bool keep);
+    size_t features();
+  }
+
+  struct FuzzOptions {
+    std::string corpusDir;          // empty means keep corpus in memory only
+    std::string crashDir = ".";     // empty means don't write failing inputs
+    std::vector<std::string> seeds; // initial inputs, e.g., valid examples
+    size_t maxRuns = 100000;
+    Nanoseconds maxTime{ 0 };       // zero means no limit
+    size_t maxLength = 256;
+    uint64_t seed = 1;
+    size_t minimizeRuns = 10000;
+  };
+
+  struct FuzzResult {
+    bool passed = true;
+    bool instrumented = false;
+    size_t runs = 0;
+    size_t corpusSize = 0;
+    size_t features = 0;
+    double execsPerSecond = 0.0;
+    std::string message;            // why the failing input failed
+    std::string input;              // failing input, as found
+    std::string minimized;          // failing input, minimized
+    std::string savedTo;
+  };
+
+  namespace detail {
+
+    using SignalHandler = void (*)(int);
+
+    /* read by the crash handler, so kept in plain globals */
+    inline const std::string* pFuzzInput = nullptr;
+    inline std::string fuzzCrashPath;
+    inline const int fuzzSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+    inline SignalHandler fuzzPrevious[] = { SIG_DFL, SIG_DFL, SIG_DFL, SIG_DFL };
+
+    inline SignalHandler previousHandler(int sig) {
+      for (size_t i = 0; i < std::size(fuzzSignals); ++i)
+        if (fuzzSignals[i] == sig)
+          return fuzzPrevious[i];
+      return SIG_DFL;
+    }
+    /*-- save crashing input, then hand the signal to the handler fuzz() replaced --*/
+    inline void onFuzzCrash(int sig) {
+      if (pFuzzInput && !fuzzCrashPath.empty()) {
+        if (std::FILE* f = std::fopen(fuzzCrashPath.c_str(), "wb")) {
+          std::fwrite(pFuzzInput->data(), 1, pFuzzInput->size(), f);
+          std::fclose(f);
+        }
+      }
+      std::signal(sig, previousHandler(sig));
+      std::raise(sig);
+    }
+    /*-- install onFuzzCrash, saving the handlers it replaces --*/
+    inline void installCrashHandlers() {
+      for (size_t i = 0; i < std::size(fuzzSignals); ++i) {
+        SignalHandler previous = std::signal(fuzzSignals[i], onFuzzCrash);
+        fuzzPrevious[i] = previous == SIG_ERR ? SIG_DFL : previous;
+      }
+    }
+    inline void restoreCrashHandlers() {
+      for (size_t i = 0; i < std::size(fuzzSignals); ++i)
+        std::signal(fuzzSignals[i], fuzzPrevious[i]);
+    }
+
+    /*-- run target once, returns empty string if it passed --*/
+    template<typename F>
+    std::string fuzzOnce(F& target, const std::string& input) {
+      try {
+        if (target(reinterpret_cast<const uint8_t*>(input.data()), input.size()))
+          return std::string();
+        return "target returned false";
+      }
+      catch (std::exception& ex) {
+        return std::string("exception: ") + ex.what();
+      }
+      catch (...) {
+        return "unknown exception";
+      }
+    }
+
+    /*-- apply one random edit, sometimes splicing in another corpus entry --*/
+    inline void mutate(std::string& s, Rng& rng, const std::vector<std::string>& corpus, size_t maxLength) {
+      static const char interesting[] = { 0, 1, '\x7f', '\x80', '\xff', '0', '9', ' ', ':', '-' };
+      switch (rng.between(0, s.empty() ? 2 : 6)) {
+      case 0:
+      case 1:
+        if (s.size() < maxLength)
+          s.insert(s.begin() + rng.between<size_t>(0, s.size()), static_cast<char>(rng()));
+        break;
+      case 2: {
+        const std::string& other = corpus[rng.between<size_t>(0, corpus.size() - 1)];
+        if (other.empty())
+          break;
+        size_t from = rng.between<size_t>(0, other.size() - 1);
+        size_t len = rng.between<size_t>(1, other.size() - from);
+        s.insert(rng.between<size_t>(0, s.size()), other, from, len);
+        break;
+      }
+      case 3:
+        s[rng.between<size_t>(0, s.size() - 1)] ^= static_cast<char>(1u << rng.between(0, 7));
+        break;
+      case 4:
+        s[rng.between<size_t>(0, s.size() - 1)] = interesting[rng.between<size_t>(0, sizeof(interesting) - 1)];
+        break;
+      case 5:
+        s[rng.between<size_t>(0, s.size() - 1)] = static_cast<char>(rng());
+        break;
+      default: {
+        size_t from = rng.between<size_t>(0, s.size() - 1);
+        s.erase(from, rng.between<size_t>(1, s.size() - from));
+        break;
+      }
+      }
+      if (s.size() > maxLength)
+        s.resize(maxLength);
+    }
+
+    inline std::string hexName(const std::string& input) {
+      std::ostringstream name;
+      name << std::hex << std::setw(16) << std::setfill('0') << stableHash(input);
+      return name.str();
+    }
+
+    inline void writeBytes(const std::filesystem::path& path, const std::string& bytes) {
+      std::ofstream out(path, std::ios::binary);
+      out.write(bytes.data(), bytes.size());
+    }
+  }
+
+  /*---------------------------------------------------
+    fuzz target until it fails, maxRuns inputs have
+    run, or maxTime has passed
+  */
+  template<typename F>
+  FuzzResult fuzz(F target, const FuzzOptions& opts = FuzzOptions()) {
+    namespace fs = std::filesystem;
+    FuzzResult result;
+    Rng rng(opts.seed);
+
+    std::vector<std::string> corpus;
+    if (!opts.corpusDir.empty()) {
+      std::error_code ec;
+      fs::create_directories(opts.corpusDir, ec);
+      for (auto& entry : fs::directory_iterator(opts.corpusDir, ec)) {
+        if (!entry.is_regular_file())
+          continue;
+        std::ifstream in(entry.path(), std::ios::binary);
+        corpus.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      }
+    }
+    for (auto& s : opts.seeds)
+      corpus.push_back(s);
+    if (corpus.empty())
+      corpus.push_back(std::string());
+
+    std::string input;
+    detail::pFuzzInput = &input;
+    detail::fuzzCrashPath.clear();
+    if (!opts.crashDir.empty())
+      detail::fuzzCrashPath = (fs::path(opts.crashDir) / "crash-in-progress").string();
+    detail::installCrashHandlers();
+
+    auto start = Clock::now();
+    auto outOfTime = [&]() {
+      return opts.maxTime.count() > 0 && Clock::now() - start >= opts.maxTime;
+    };
+    coverage::clear();
+    /* replay corpus to learn its coverage, then mutate */
+    size_t replay = corpus.size();
+    while (result.runs < opts.maxRuns && !outOfTime()) {
+      if (result.runs < replay) {
+        input = corpus[result.runs];
+      }
+      else {
+        input.assign(corpus[rng.between<size_t>(0, corpus.size() - 1)]);
+        size_t edits = rng.between<size_t>(1, 4);
+        for (size_t i = 0; i < edits; ++i)
+          detail::mutate(input, rng, corpus, opts.maxLength);
+      }
+      std::string failure = detail::fuzzOnce(target, input);
+      ++result.runs;
+      if (!failure.empty()) {
+        result.passed = false;
+        result.message = failure;
+        result.input = input;
+        break;
+      }
+      if (coverage::newFeatures(true) > 0 && result.runs > replay) {
+        corpus.push_back(input);
+        if (!opts.corpusDir.empty())
+          detail::writeBytes(fs::path(opts.corpusDir) / detail::hexName(input), input);
+      }
+    }
+    detail::restoreCrashHandlers();
+    detail::pFuzzInput = nullptr;
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.execsPerSecond = seconds > 0.0 ? result.runs / seconds : 0.0;
+    result.corpusSize = corpus.size();
+    result.features = coverage::features();
+    result.instrumented = coverage::instrumented();
+    if (result.passed)
+      return result;
+
+    /* remove ever smaller chunks while the input still fails the same way */
+    std::string best = result.input;
+    size_t tries = 0;
+    for (size_t chunk = best.size() / 2; chunk >= 1 && tries < opts.minimizeRuns; chunk /= 2) {
+      for (size_t pos = 0; pos + chunk <= best.size() && tries < opts.minimizeRuns; ++tries) {
+        std::string candidate = best;
+        candidate.erase(pos, chunk);
+        if (detail::fuzzOnce(target, candidate) == result.message)
+          best = std::move(candidate);
+        else
+          pos += chunk;
+      }
+    }
+    result.minimized = best;
+    if (!opts.crashDir.empty()) {
+      std::error_code ec;
+      fs::create_directories(opts.crashDir, ec);
+      fs::path path = fs::path(opts.crashDir) / ("crash-" + detail::hexName(best));
+      detail::writeBytes(path, best);
+      result.savedTo = path.string();
+    }
+    return result;
+  }
+
+  /*-- printable form of input bytes --*/
+  inline std::string escapeBytes(const std::string& bytes) {
+    std::ostringstream out;
+    out << '"';
+    for (unsigned char ch : bytes) {
+      if (ch == '"' || ch == '\\')
+        out << '\\' << ch;
+      else if (ch >= 0x20 && ch < 0x7f)
+        out << ch;
+      else
+        out << "\\x" << std::hex << std::setw(2) << std::setfill('0') << int(ch) << std::dec;
+    }
+    out << '"';
+    return out.str();
+  }
+
+  inline void showFuzz(const FuzzResult& r, std::ostream& out) {
+    out << "\n  " << r.runs << " runs, " << static_cast<size_t>(r.execsPerSecond) << " execs/s, corpus "
+      << r.corpusSize << ", features " << r.features;
+    if (!r.instrumented)
+      out << "\n  no coverage instrumentation, mutating seeds only";
+    if (r.passed)
+      return;
+    out << "\n  failing input: " << escapeBytes(r.input);
+    out << "\n  minimized to:  " << escapeBytes(r.minimized);
+    out << "\n  " << r.message;
+    if (!r.savedTo.empty())
+      out << "\n  saved to " << r.savedTo;
+  }
+  /*-- report fuzz result as one note --*/
+  inline void showFuzz(const FuzzResult& r, Reporter& reporter = defaultReporter()) {
+    std::ostringstream out;
+    showFuzz(r, out);
+    noteLines(reporter, out.str());
+  }
+}
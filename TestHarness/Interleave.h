@@ -0,0 +1,608 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Interleave.h - explore thread interleavings of a test   //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Runs small concurrency tests, e.g., two producers and a
+   consumer sharing a BlockingQueue, under a cooperative
+   scheduler that lets one thread run at a time and switches
+   threads only at scheduling points, so every schedule can be
+   run again exactly:
+   - scheduling points are stressPoint() calls, ScheduledMutex
+     locks, and ScheduledConditionVariable waits; unlocking
+     never switches threads, so it can't throw from a
+     lock_guard destructor
+   - random mode samples opts.schedules schedules, schedule i
+     seeded with opts.seed + i
+   - systematic mode enumerates schedules depth first, with
+     at most opts.maxPreemptions switches away from a thread
+     that could have continued; most concurrency bugs need
+     only one or two preemptions, so a small bound finds them
+     in far fewer schedules than stress looping
+   - a schedule fails if a thread or end check returns false,
+     fails a TEST_CHECK, or throws, if every unfinished thread
+     is blocked, or if it passes opts.maxSteps scheduling points
+   - the first failing schedule is reported with its seed and
+     its choices; run it again by setting opts.seed to the seed
+     and opts.schedules to 1, or by setting opts.replay to the
+     choices
+
+   Threads may block only in the scheduled primitives, a thread
+   blocked anywhere else, e.g., on a std::mutex, stalls the run.
+   Apart from scheduling, scenarios must be deterministic for
+   their schedules to replay.
+
+   Example:
+     using Queue = BlockingQueue<int, ScheduledMutex, ScheduledConditionVariable>;
+     seq.reg(interleavings([](Interleaving& x) {
+       auto q = std::make_shared<Queue>();
+       x.spawn([q]() { q->enQ(1); });
+       x.spawn([q]() { q->enQ(2); });
+       x.spawn([q]() { int a = q->deQ(); TEST_CHECK(a + q->deQ() == 3); return true; });
+     }), "queueSum");
+
+   Package Dependencies:
+  -----------------------
+   Interleave.h
+   Stress.h (stressPoint)
+   PropertyTest.h (Rng)
+   TestCallable.h
+   TestAssertions.h (failure slot)
+   Reporter.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.1 - 17 Oct 2026
+   - results may be shown through a Reporter
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <limits>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include "Stress.h"
+#include "PropertyTest.h"
+#include "TestCallable.h"
+#include "Reporter.h"
+#include "../TestUtilities/TestAssertions.h"
+
+namespace Test {
+
+  struct InterleaveOptions {
+    size_t schedules = 1000;      // schedules to run, at most
+    bool systematic = false;      // enumerate depth first instead of sampling
+    size_t maxPreemptions = 2;    // systematic mode only
+    size_t maxSteps = 10000;      // scheduling points per schedule
+    uint64_t seed = 1;
+    std::string replay;           // run only this schedule, e.g., "0.2.1"
+  };
+
+  struct InterleaveResult {
+    std::string name;
+    bool passed = true;
+    size_t schedules = 0;         // schedules run, up to and including failure
+    bool exhausted = false;       // systematic run covered every schedule in bound
+    bool sampled = false;         // schedules were sampled at random
+    uint64_t seed = 0;            // failing schedule's seed, if sampled
+    std::string schedule;         // failing schedule's choices
+    std::string message;
+  };
+
+  ///////////////////////////////////////////////
+  // Interleaving class - threads of one schedule
+
+  class Interleaving {
+  public:
+    /*-- add a thread, body returns void or bool, false fails the schedule --*/
+    template<typename F>
+    void spawn(F body) {
+      threads_.push_back(wrap(std::move(body)));
+    }
+    /*-- add a check run after every thread has finished --*/
+    template<typename F>
+    void atEnd(F check) {
+      checks_.push_back(wrap(std::move(check)));
+    }
+    std::vector<TestCallable>& threads() {
+      return threads_;
+    }
+    std::vector<TestCallable>& checks() {
+      return checks_;
+    }
+  private:
+    template<typename F>
+    static TestCallable wrap(F f) {
+      if constexpr (std::is_void_v<std::invoke_result_t<F&>>)
+        return TestCallable([f = std::move(f)]() mutable { f(); return true; });
+      else
+        return TestCallable(std::move(f));
+    }
+    std::vector<TestCallable> threads_;
+    std::vector<TestCallable> checks_;
+  };
+
+  namespace detail {
+
+    /*-- thrown to unwind the threads of an abandoned schedule --*/
+    struct InterleaveAbort {};
+
+    /////////////////////////////////////////////
+    // Scheduler class - runs one schedule
+
+    class Scheduler {
+    public:
+      static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+      /*-- one scheduling decision with more than one enabled thread --*/
+      struct Choice {
+        size_t taken = 0;
+        size_t alternatives = 0;  // choices the search may take
+      };
+
+      Scheduler(const InterleaveOptions& opts, std::vector<size_t> prefix, uint64_t seed, bool random)
+        : opts_(opts), prefix_(std::move(prefix)), rng_(seed), random_(random) {}
+
+      /*-- run bodies one at a time to completion, returns false if schedule failed --*/
+      bool run(std::vector<TestCallable>& bodies) {
+        threads_.assign(bodies.size(), ThreadState());
+        std::vector<std::thread> threads;
+        threads.reserve(bodies.size());
+        for (size_t i = 0; i < bodies.size(); ++i)
+          threads.emplace_back([this, &bodies, i]() { threadProc(bodies[i], i); });
+        {
+          std::unique_lock<std::mutex> l(mtx_);
+          current_ = bodies.empty() ? none : choose(none);
+          cv_.notify_all();
+          cv_.wait(l, [this]() { return finished_ == threads_.size(); });
+        }
+        for (auto& th : threads)
+          th.join();
+        return message_.empty();
+      }
+      /*-- current thread lets the scheduler pick who runs next --*/
+      void point() {
+        std::unique_lock<std::mutex> l(mtx_);
+        if (unwinding())
+          return;
+        size_t me = self();
+        size_t next = choose(me);
+        if (next == none) {
+          fail("deadlock, every unfinished thread is blocked");
+          throw InterleaveAbort();
+        }
+        handTo(next, me, l);
+      }
+      /*-- mark current thread blocked on on, it runs again only after wake(on) --*/
+      void markBlocked(const void* on) {
+        std::lock_guard<std::mutex> l(mtx_);
+        threads_[self()].blocked = true;
+        threads_[self()].on = on;
+      }
+      /*-- current thread waits until another wakes it --*/
+      void block(const void* on) {
+        markBlocked(on);
+        point();
+      }
+      /*-- return once current thread, marked blocked, was woken and scheduled again --*/
+      void awaitWake() {
+        bool blocked = false;
+        {
+          std::lock_guard<std::mutex> l(mtx_);
+          blocked = threads_[self()].blocked;
+        }
+        if (blocked)
+          point();
+      }
+      /*-- make threads blocked on on runnable, the first or all --*/
+      void wake(const void* on, bool all) {
+        std::lock_guard<std::mutex> l(mtx_);
+        for (auto& t : threads_) {
+          if (t.blocked && t.on == on) {
+            t.blocked = false;
+            if (!all)
+              break;
+          }
+        }
+      }
+      bool aborting() {
+        std::lock_guard<std::mutex> l(mtx_);
+        return aborting_;
+      }
+      const std::vector<Choice>& choices() const {
+        return choices_;
+      }
+      const std::string& message() const {
+        return message_;
+      }
+    private:
+      struct ThreadState {
+        bool blocked = false;
+        bool done = false;
+        const void* on = nullptr;
+      };
+
+      static size_t self();
+
+      void threadProc(TestCallable& body, size_t me);
+
+      /*-- true if abandoning the schedule, throws unless already unwinding --*/
+      bool unwinding() {
+        if (!aborting_)
+          return false;
+        if (std::uncaught_exceptions() == 0)
+          throw InterleaveAbort();
+        return true;
+      }
+      /*---------------------------------------------------
+        pick the next thread to run, from is the thread
+        giving up control, none at start
+        - from comes first, so choice 0 never preempts
+        - returns none if no thread is enabled
+      */
+      size_t choose(size_t from) {
+        std::vector<size_t> enabled;
+        size_t n = threads_.size();
+        size_t start = from == none ? 0 : from;
+        for (size_t k = 0; k < n; ++k) {
+          const ThreadState& t = threads_[(start + k) % n];
+          if (!t.done && !t.blocked)
+            enabled.push_back((start + k) % n);
+        }
+        if (enabled.empty())
+          return none;
+        if (from != none && ++steps_ > opts_.maxSteps) {
+          fail("more than " + std::to_string(opts_.maxSteps) + " scheduling points, livelock?");
+          throw InterleaveAbort();
+        }
+        if (enabled.size() == 1)
+          return enabled[0];
+
+        bool continues = enabled[0] == from;
+        size_t alternatives = enabled.size();
+        if (!random_ && continues && preemptions_ >= opts_.maxPreemptions)
+          alternatives = 1;
+        size_t pick = 0;
+        size_t k = choices_.size();
+        if (k < prefix_.size())
+          pick = std::min(prefix_[k], enabled.size() - 1);
+        else if (random_)
+          pick = rng_.between<size_t>(0, alternatives - 1);
+        if (continues && pick > 0)
+          ++preemptions_;
+        choices_.push_back(Choice{ pick, alternatives });
+        return enabled[pick];
+      }
+      /*-- give control to next, and wait for it to come back --*/
+      void handTo(size_t next, size_t me, std::unique_lock<std::mutex>& l) {
+        current_ = next;
+        if (next == me)
+          return;
+        cv_.notify_all();
+        cv_.wait(l, [this, me]() { return current_ == me; });
+        unwinding();
+      }
+      void fail(const std::string& why) {
+        if (message_.empty())
+          message_ = why;
+        aborting_ = true;
+      }
+
+      InterleaveOptions opts_;
+      std::vector<size_t> prefix_;
+      Rng rng_;
+      bool random_;
+      std::mutex mtx_;
+      std::condition_variable cv_;
+      std::vector<ThreadState> threads_;
+      size_t current_ = none;
+      size_t finished_ = 0;
+      size_t steps_ = 0;
+      size_t preemptions_ = 0;
+      bool aborting_ = false;
+      std::vector<Choice> choices_;
+      std::string message_;
+    };
+
+    /*-- explorer state of a scheduled thread, empty elsewhere --*/
+    struct Scheduled {
+      Scheduler* scheduler = nullptr;
+      size_t index = 0;
+    };
+    inline Scheduled& scheduled() {
+      thread_local Scheduled s;
+      return s;
+    }
+    inline void schedulePoint() {
+      scheduled().scheduler->point();
+    }
+
+    inline size_t Scheduler::self() {
+      return scheduled().index;
+    }
+
+    inline void Scheduler::threadProc(TestCallable& body, size_t me) {
+      scheduled() = Scheduled{ this, me };
+      stressPoints().schedule = &schedulePoint;
+      std::string why;
+      {
+        std::unique_lock<std::mutex> l(mtx_);
+        cv_.wait(l, [this, me]() { return current_ == me; });
+      }
+      if (!aborting()) {
+        FailureScope failure;
+        try {
+          if (!body() || failure.failed())
+            why = failure.failed() ? failure.message() : "thread returned false";
+        }
+        catch (InterleaveAbort&) {}
+        catch (std::exception& ex) {
+          why = ex.what();
+        }
+        catch (...) {
+          why = "unknown exception";
+        }
+      }
+      stressPoints().schedule = nullptr;
+      scheduled() = Scheduled();
+
+      std::lock_guard<std::mutex> l(mtx_);
+      if (!why.empty())
+        message_ = message_.empty() ? "thread " + std::to_string(me) + ": " + why : message_;
+      threads_[me].done = true;
+      if (++finished_ == threads_.size()) {
+        cv_.notify_all();
+        return;
+      }
+      size_t next = none;
+      if (!aborting_) {
+        try {
+          next = choose(me);
+        }
+        catch (InterleaveAbort&) {}
+        if (next == none && !aborting_)
+          fail("deadlock, every unfinished thread is blocked");
+      }
+      if (aborting_) {
+        for (size_t i = 0; i < threads_.size() && next == none; ++i)
+          if (!threads_[i].done)
+            next = i;
+      }
+      current_ = next;
+      cv_.notify_all();
+    }
+
+    /*-- true if this thread is run by an explorer --*/
+    inline bool isScheduled() {
+      return scheduled().scheduler != nullptr;
+    }
+  }
+
+  ///////////////////////////////////////////////
+  // ScheduledMutex class
+  // - a std::mutex outside explorer runs
+  // - under an explorer, locking is a scheduling point,
+  //   and a thread waiting for the lock is blocked, not
+  //   spinning
+
+  class ScheduledMutex {
+  public:
+    ScheduledMutex() = default;
+    ScheduledMutex(const ScheduledMutex&) = delete;
+    ScheduledMutex& operator=(const ScheduledMutex&) = delete;
+
+    void lock() {
+      if (!detail::isScheduled()) {
+        mtx_.lock();
+        return;
+      }
+      detail::Scheduler* s = detail::scheduled().scheduler;
+      s->point();
+      while (held_ && !s->aborting())
+        s->block(this);
+      held_ = true;
+    }
+    void unlock() {
+      if (!detail::isScheduled()) {
+        mtx_.unlock();
+        return;
+      }
+      held_ = false;
+      detail::scheduled().scheduler->wake(this, true);
+    }
+  private:
+    std::mutex mtx_;
+    bool held_ = false;             // explorer runs only, one thread runs at a time
+  };
+
+  ///////////////////////////////////////////////
+  // ScheduledConditionVariable class
+  // - a std::condition_variable_any outside explorer runs
+  // - under an explorer, waiting blocks the thread until
+  //   notified, so lost wakeups show up as deadlocks
+
+  class ScheduledConditionVariable {
+  public:
+    ScheduledConditionVariable() = default;
+    ScheduledConditionVariable(const ScheduledConditionVariable&) = delete;
+    ScheduledConditionVariable& operator=(const ScheduledConditionVariable&) = delete;
+
+    template<typename Lock>
+    void wait(Lock& l) {
+      if (!detail::isScheduled()) {
+        cv_.wait(l);
+        return;
+      }
+      detail::Scheduler* s = detail::scheduled().scheduler;
+      struct Relock {
+        Lock& l;
+        ~Relock() { l.lock(); }
+      } relock{ l };
+      s->markBlocked(this);       // before unlocking, so no notify is missed
+      l.unlock();
+      s->awaitWake();
+    }
+    template<typename Lock, typename P>
+    void wait(Lock& l, P pred) {
+      while (!pred())
+        wait(l);
+    }
+    void notify_one() {
+      if (detail::isScheduled())
+        detail::scheduled().scheduler->wake(this, false);
+      else
+        cv_.notify_one();
+    }
+    void notify_all() {
+      if (detail::isScheduled())
+        detail::scheduled().scheduler->wake(this, true);
+      else
+        cv_.notify_all();
+    }
+  private:
+    std::condition_variable_any cv_;
+  };
+
+  namespace detail {
+    inline std::string scheduleText(const std::vector<Scheduler::Choice>& choices) {
+      std::string text;
+      for (size_t i = 0; i < choices.size(); ++i)
+        text += (i ? "." : "") + std::to_string(choices[i].taken);
+      return text;
+    }
+    inline std::vector<size_t> parseSchedule(const std::string& text) {
+      std::vector<size_t> choices;
+      size_t pos = 0;
+      while (pos < text.size()) {
+        size_t dot = text.find('.', pos);
+        if (dot == std::string::npos)
+          dot = text.size();
+        size_t used = 0;
+        std::string item = text.substr(pos, dot - pos);
+        unsigned long value = 0;
+        try {
+          value = std::stoul(item, &used);
+        }
+        catch (std::exception&) {}
+        if (item.empty() || used != item.size())
+          throw std::invalid_argument("bad schedule \"" + text + "\", expected choices like 0.2.1");
+        choices.push_back(value);
+        pos = dot + 1;
+      }
+      return choices;
+    }
+    /*-- end checks of a finished schedule, empty if all hold --*/
+    inline std::string checkEnd(Interleaving& x) {
+      for (auto& check : x.checks()) {
+        FailureScope failure;
+        try {
+          if (!check() || failure.failed())
+            return "end check: " + (failure.failed() ? failure.message() : std::string("returned false"));
+        }
+        catch (std::exception& ex) {
+          return std::string("end check: ") + ex.what();
+        }
+        catch (...) {
+          return "end check: unknown exception";
+        }
+      }
+      return std::string();
+    }
+  }
+
+  /*---------------------------------------------------
+    run scenario under opts.schedules schedules, or
+    until one fails
+    - scenario(Interleaving&) builds fresh shared state
+      and spawns threads for each schedule
+    - systematic runs stop early, exhausted, once every
+      schedule within the preemption bound has run
+  */
+  template<typename S>
+  InterleaveResult explore(S scenario, const std::string& name = "", const InterleaveOptions& opts = InterleaveOptions()) {
+    InterleaveResult result;
+    result.name = name;
+    bool replaying = !opts.replay.empty();
+    std::vector<size_t> prefix = replaying ? detail::parseSchedule(opts.replay) : std::vector<size_t>();
+    size_t schedules = replaying ? 1 : opts.schedules;
+    bool random = !opts.systematic && !replaying;
+
+    for (size_t i = 0; i < schedules; ++i) {
+      uint64_t seed = opts.seed + i;
+      Interleaving x;
+      scenario(x);
+      detail::Scheduler scheduler(opts, prefix, seed, random);
+      scheduler.run(x.threads());
+      std::string message = scheduler.message();
+      if (message.empty())
+        message = detail::checkEnd(x);
+      ++result.schedules;
+      if (!message.empty()) {
+        result.passed = false;
+        result.sampled = random;
+        result.seed = seed;
+        result.schedule = detail::scheduleText(scheduler.choices());
+        result.message = message;
+        return result;
+      }
+      if (random || replaying)
+        continue;
+
+      /*-- next schedule depth first: advance the deepest choice with alternatives left --*/
+      const auto& choices = scheduler.choices();
+      size_t k = choices.size();
+      while (k > 0 && choices[k - 1].taken + 1 >= choices[k - 1].alternatives)
+        --k;
+      if (k == 0) {
+        result.exhausted = true;
+        return result;
+      }
+      prefix.clear();
+      for (size_t j = 0; j + 1 < k; ++j)
+        prefix.push_back(choices[j].taken);
+      prefix.push_back(choices[k - 1].taken + 1);
+    }
+    return result;
+  }
+
+  inline void showInterleave(const InterleaveResult& r, std::ostream& out) {
+    out << "\n  " << r.name << (r.passed ? " passed, " : " failed, ") << r.schedules << " schedules";
+    if (r.exhausted)
+      out << ", all within preemption bound";
+    if (r.passed)
+      return;
+    out << "\n    ";
+    if (r.sampled)
+      out << "seed " << r.seed << ", ";
+    out << "schedule " << (r.schedule.empty() ? "<no choices>" : r.schedule);
+    out << "\n    " << r.message;
+  }
+  /*-- report exploration result as one note --*/
+  inline void showInterleave(const InterleaveResult& r, Reporter& reporter = defaultReporter()) {
+    std::ostringstream out;
+    showInterleave(r, out);
+    noteLines(reporter, out.str());
+  }
+
+  /*-- interleaving test for TestSequencer::reg, reports the failing schedule --*/
+  template<typename S>
+  TestCallable interleavings(S scenario, const InterleaveOptions& opts = InterleaveOptions()) {
+    return [scenario = std::move(scenario), opts]() {
+      InterleaveResult r = explore(scenario, "interleavings", opts);
+      if (!r.passed)
+        showInterleave(r);
+      return r.passed;
+    };
+  }
+}
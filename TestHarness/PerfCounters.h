@@ -0,0 +1,203 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// PerfCounters.h - per-thread hardware event counters     //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Counts cpu events for the calling thread while a test runs:
+   - PerfCounts holds cycles, instructions, cache references and
+     misses, branch misses, context switches, page faults, and
+     task clock time
+   - PerfGroup opens the counters once per thread as a single
+     perf_event group, so all are enabled, disabled, and read
+     together with one read()
+   - if the kernel refuses hardware events, e.g., in a virtual
+     machine or with a restrictive perf_event_paranoid setting,
+     the group falls back to software events only
+   - if no events can be opened, or on platforms other than
+     Linux, counts are marked unavailable and tests still run
+
+   Package Dependencies:
+  -----------------------
+   PerfCounters.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <cstdint>
+#include <iostream>
+
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <cstring>
+  #include <array>
+  #include <vector>
+#endif
+
+namespace Test {
+
+  struct PerfCounts {
+    bool available = false;
+    bool hardware = false;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheReferences = 0;
+    uint64_t cacheMisses = 0;
+    uint64_t branchMisses = 0;
+    uint64_t contextSwitches = 0;
+    uint64_t pageFaults = 0;
+    uint64_t taskClockNs = 0;
+  };
+
+  /*-- display counts on one indented line --*/
+  inline void showCounters(const PerfCounts& c, std::ostream& out = std::cout) {
+    if (!c.available) {
+      out << "\n    counters unavailable";
+      return;
+    }
+    out << "\n    ";
+    if (c.hardware) {
+      out << "cycles " << c.cycles << ", instructions " << c.instructions
+        << ", cache refs " << c.cacheReferences << ", cache misses " << c.cacheMisses
+        << ", branch misses " << c.branchMisses << ", ";
+    }
+    out << "context switches " << c.contextSwitches << ", page faults " << c.pageFaults
+      << ", task clock " << c.taskClockNs << " ns";
+  }
+
+#ifdef __linux__
+
+  ///////////////////////////////////////////////
+  // PerfGroup class - Linux perf_event group
+
+  class PerfGroup {
+  public:
+    PerfGroup() {
+      open(true);
+      if (fds_.empty())
+        open(false);
+    }
+    PerfGroup(const PerfGroup&) = delete;
+    PerfGroup& operator=(const PerfGroup&) = delete;
+    ~PerfGroup() {
+      close();
+    }
+    /*-- one group per thread, opened on first use --*/
+    static PerfGroup& forThisThread() {
+      thread_local PerfGroup group;
+      return group;
+    }
+    bool available() const {
+      return !fds_.empty();
+    }
+    /*-- zero and enable all counters --*/
+    void start() {
+      if (fds_.empty())
+        return;
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    /*-- disable counters and read them atomically --*/
+    PerfCounts stop() {
+      PerfCounts counts;
+      if (fds_.empty())
+        return counts;
+      ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+      /* layout for PERF_FORMAT_GROUP with enabled and running times */
+      std::array<uint64_t, 3 + maxEvents> buf{};
+      ssize_t bytes = read(fds_[0], buf.data(), buf.size() * sizeof(uint64_t));
+      if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+        return counts;
+      uint64_t nr = buf[0], enabled = buf[1], running = buf[2];
+      /* scale up if kernel multiplexed the group with others */
+      double scale = (running > 0 && running < enabled)
+        ? static_cast<double>(enabled) / running : 1.0;
+      for (uint64_t i = 0; i < nr && i < fields_.size(); ++i)
+        counts.*fields_[i] = static_cast<uint64_t>(buf[3 + i] * scale);
+      counts.available = true;
+      counts.hardware = hardware_;
+      return counts;
+    }
+  private:
+    using Field = uint64_t PerfCounts::*;
+    static constexpr size_t maxEvents = 8;
+
+    /*-- count kernel activity too, if the kernel allows it --*/
+    bool add(uint32_t type, uint64_t config, Field field) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = type;
+      attr.config = config;
+      attr.disabled = fds_.empty() ? 1 : 0;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP
+        | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      int leader = fds_.empty() ? -1 : fds_[0];
+      int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+      if (fd < 0) {
+        attr.exclude_kernel = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+      }
+      if (fd < 0)
+        return false;
+      fds_.push_back(fd);
+      fields_.push_back(field);
+      return true;
+    }
+    /*-- hardware group must open completely, or not at all --*/
+    void open(bool hardware) {
+      hardware_ = hardware;
+      bool ok = true;
+      if (hardware) {
+        ok = add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfCounts::cycles)
+          && add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &PerfCounts::instructions)
+          && add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, &PerfCounts::cacheReferences)
+          && add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, &PerfCounts::cacheMisses)
+          && add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &PerfCounts::branchMisses);
+      }
+      ok = ok
+        && add(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, &PerfCounts::taskClockNs)
+        && add(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, &PerfCounts::contextSwitches)
+        && add(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, &PerfCounts::pageFaults);
+      if (!ok)
+        close();
+    }
+    void close() {
+      for (auto it = fds_.rbegin(); it != fds_.rend(); ++it)
+        ::close(*it);
+      fds_.clear();
+      fields_.clear();
+    }
+    std::vector<int> fds_;
+    std::vector<Field> fields_;
+    bool hardware_ = false;
+  };
+
+#else
+
+  ///////////////////////////////////////////////
+  // PerfGroup class - counters not supported
+
+  class PerfGroup {
+  public:
+    static PerfGroup& forThisThread() {
+      thread_local PerfGroup group;
+      return group;
+    }
+    bool available() const { return false; }
+    void start() {}
+    PerfCounts stop() { return PerfCounts(); }
+  };
+
+#endif
+}
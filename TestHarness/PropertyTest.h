@@ -0,0 +1,474 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// PropertyTest.h - parameterised and property based tests //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Evaluates one test body over many inputs:
+   - forAll(gen, property) checks property on opts.cases inputs
+     made by generator gen, in chunks spread over a ThreadPool
+   - each chunk owns one input buffer that the generator writes
+     into, so vectors and strings keep their capacity and most
+     cases don't allocate
+   - case i is generated from its own seed, derived from
+     opts.seed and i, so the reported failure, the lowest
+     failing case, doesn't depend on thread count or timing
+   - a failing input is shrunk, using the generator's shrink()
+     candidates, to a small input that still fails
+   - forEach(values, body) runs body once per listed parameter,
+     in parallel, reporting every failing parameter
+   Both return a TestCallable for TestSequencer::reg, and record
+   the counterexample or failing parameters as the failure, so
+   they reach TestResult::message.  Called on a pool worker,
+   e.g., in a parallel run, they evaluate inline instead of
+   starting a nested pool.
+
+   Generators are function objects with:
+     using value_type = T;
+     void operator()(Rng& rng, T& out);          // fill out
+     std::vector<T> shrink(const T& failing);    // optional
+   integers(lo, hi), vectorsOf(gen, maxSize), and strings(maxLength)
+   are provided; generate<T>(f) wraps a lambda as a generator
+   without shrinking.
+
+   Example:
+     seq.reg(forAll(vectorsOf(integers(-100, 100), 50),
+       [](const std::vector<int>& v) { return reversedTwice(v) == v; }),
+       "reverseInvolution");
+
+   Package Dependencies:
+  -----------------------
+   PropertyTest.h
+   ThreadPool.h
+   TestCallable.h
+   TestAssertions.h (failure slot)
+   Reporter.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.3 - 17 Oct 2026
+   - forAll and forEach record failures for the test's result,
+     and run inline on pool workers
+   ver 1.2 - 17 Oct 2026
+   - counterexamples and failing parameters go to a Reporter
+   ver 1.1 - 17 Oct 2026
+   - properties may fail with TEST_CHECK instead of throwing
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <limits>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include "ThreadPool.h"
+#include "TestCallable.h"
+#include "Reporter.h"
+#include "../TestUtilities/TestAssertions.h"
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // Rng class - splitmix64, small and fast to seed
+
+  class Rng {
+  public:
+    explicit Rng(uint64_t seed) : state_(seed) {}
+
+    uint64_t operator()() {
+      return mix(state_ += 0x9E3779B97F4A7C15ULL);
+    }
+    /*-- uniform in [lo, hi], modulo bias is negligible for tests --*/
+    template<typename I>
+    I between(I lo, I hi) {
+      static_assert(std::is_integral_v<I>, "between requires an integral type");
+      uint64_t range = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo) + 1;
+      uint64_t r = (*this)();
+      if (range == 0)
+        return static_cast<I>(r);
+      return static_cast<I>(static_cast<uint64_t>(lo) + r % range);
+    }
+    /*-- seed of case i, independent of other cases --*/
+    static uint64_t caseSeed(uint64_t seed, size_t i) {
+      return mix(seed + mix(static_cast<uint64_t>(i)));
+    }
+    static uint64_t mix(uint64_t z) {
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+  private:
+    uint64_t state_;
+  };
+
+  ///////////////////////////////////////////////
+  // generators
+
+  template<typename I>
+  struct Integers {
+    using value_type = I;
+    I lo, hi;
+
+    void operator()(Rng& rng, I& out) const {
+      out = rng.between(lo, hi);
+    }
+    /*-- steps toward zero, or the bound nearest zero --*/
+    std::vector<I> shrink(const I& x) const {
+      I target = std::clamp<I>(I(0), lo, hi);
+      std::vector<I> candidates;
+      if (x == target)
+        return candidates;
+      using Wide = std::conditional_t<std::is_signed_v<I>, long long, unsigned long long>;
+      Wide wx = static_cast<Wide>(x), wt = static_cast<Wide>(target);
+      bool below = wx < wt;
+      Wide distance = below ? wt - wx : wx - wt;
+      for (Wide step = distance; step > 0; step /= 2)
+        candidates.push_back(static_cast<I>(below ? wx + step : wx - step));
+      return candidates;
+    }
+  };
+  template<typename I>
+  Integers<I> integers(I lo, I hi) {
+    return Integers<I>{ lo, hi };
+  }
+
+  template<typename G, typename = void>
+  struct HasShrink : std::false_type {};
+  template<typename G>
+  struct HasShrink<G, std::void_t<
+    decltype(std::declval<const G&>().shrink(std::declval<const typename G::value_type&>()))
+  >> : std::true_type {};
+
+  /*-- remove halves, then single elements, of a sequence --*/
+  template<typename S>
+  void shrinkSequence(const S& s, std::vector<S>& candidates) {
+    if (s.empty())
+      return;
+    candidates.push_back(S());
+    size_t half = s.size() / 2;
+    if (half > 0) {
+      candidates.push_back(S(s.begin(), s.begin() + half));
+      candidates.push_back(S(s.begin() + half, s.end()));
+    }
+    for (size_t i = 0; i < s.size() && s.size() > 1; ++i) {
+      S shorter(s);
+      shorter.erase(shorter.begin() + i);
+      candidates.push_back(std::move(shorter));
+    }
+  }
+
+  template<typename G>
+  struct VectorsOf {
+    using value_type = std::vector<typename G::value_type>;
+    G element;
+    size_t maxSize;
+
+    void operator()(Rng& rng, value_type& out) const {
+      out.resize(rng.between<size_t>(0, maxSize));
+      for (auto& e : out)
+        element(rng, e);
+    }
+    /*-- shorter vectors first, then smaller elements --*/
+    std::vector<value_type> shrink(const value_type& v) const {
+      std::vector<value_type> candidates;
+      shrinkSequence(v, candidates);
+      if constexpr (HasShrink<G>::value) {
+        for (size_t i = 0; i < v.size(); ++i) {
+          for (auto& smaller : element.shrink(v[i])) {
+            value_type changed(v);
+            changed[i] = smaller;
+            candidates.push_back(std::move(changed));
+          }
+        }
+      }
+      return candidates;
+    }
+  };
+  template<typename G>
+  VectorsOf<G> vectorsOf(G element, size_t maxSize) {
+    return VectorsOf<G>{ std::move(element), maxSize };
+  }
+
+  struct Strings {
+    using value_type = std::string;
+    size_t maxLength;
+    std::string alphabet;
+
+    void operator()(Rng& rng, std::string& out) const {
+      out.resize(rng.between<size_t>(0, maxLength));
+      for (auto& ch : out)
+        ch = alphabet[rng.between<size_t>(0, alphabet.size() - 1)];
+    }
+    /*-- shorter strings first, then characters replaced by the first letter --*/
+    std::vector<std::string> shrink(const std::string& s) const {
+      std::vector<std::string> candidates;
+      shrinkSequence(s, candidates);
+      for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] != alphabet[0]) {
+          std::string simpler(s);
+          simpler[i] = alphabet[0];
+          candidates.push_back(std::move(simpler));
+        }
+      }
+      return candidates;
+    }
+  };
+  inline Strings strings(
+    size_t maxLength, std::string alphabet = "abcdefghijklmnopqrstuvwxyz0123456789 "
+  ) {
+    return Strings{ maxLength, std::move(alphabet) };
+  }
+
+  template<typename T, typename F>
+  struct Generated {
+    using value_type = T;
+    F fill;
+
+    void operator()(Rng& rng, T& out) const {
+      fill(rng, out);
+    }
+  };
+  /*-- wrap void(Rng&, T&) as a generator that doesn't shrink --*/
+  template<typename T, typename F>
+  Generated<T, F> generate(F fill) {
+    return Generated<T, F>{ std::move(fill) };
+  }
+
+  ///////////////////////////////////////////////
+  // describing inputs
+
+  template<typename T, typename = void>
+  struct IsPrintable : std::false_type {};
+  template<typename T>
+  struct IsPrintable<T, std::void_t<
+    decltype(std::declval<std::ostream&>() << std::declval<const T&>())
+  >> : std::true_type {};
+
+  template<typename T>
+  std::string describe(const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      return "\"" + value + "\"";
+    }
+    else if constexpr (IsPrintable<T>::value) {
+      std::ostringstream out;
+      out << value;
+      return out.str();
+    }
+    else {
+      return "<unprintable>";
+    }
+  }
+  template<typename E>
+  std::string describe(const std::vector<E>& values) {
+    std::string text = "[";
+    for (size_t i = 0; i < values.size(); ++i)
+      text += (i ? ", " : "") + describe(values[i]);
+    return text + "]";
+  }
+
+  ///////////////////////////////////////////////
+  // property checks
+
+  struct PropertyOptions {
+    size_t cases = 10000;
+    size_t chunk = 1024;        // cases per pool task
+    uint64_t seed = 1;          // change to explore other inputs
+    size_t threads = 0;         // zero means one per hardware thread
+    size_t maxShrinks = 1000;
+  };
+
+  struct PropertyResult {
+    bool passed = true;
+    size_t cases = 0;           // cases checked, up to and including failure
+    size_t failingCase = 0;
+    uint64_t seed = 0;
+    std::string counterexample;
+    std::string shrunk;
+    size_t shrinkSteps = 0;
+    std::string message;        // failed TEST_CHECK or exception text
+  };
+
+  namespace detail {
+    /*-- run property, treating exceptions and failed checks as failure --*/
+    template<typename P, typename T>
+    bool holds(P& property, const T& value, std::string& message) {
+      FailureScope failure;
+      try {
+        if (property(value) && !failure.failed())
+          return true;
+        message = failure.message();
+        return false;
+      }
+      catch (std::exception& ex) {
+        message = ex.what();
+      }
+      catch (...) {
+        message = "unknown exception";
+      }
+      return false;
+    }
+    /*-- task(i) for i in [0, n), on threads workers, inline if already on a pool worker --*/
+    template<typename F>
+    void runTasks(size_t n, size_t threads, F&& task) {
+      if (threads == 1 || ThreadPool::onWorker()) {
+        for (size_t i = 0; i < n; ++i)
+          task(i);
+        return;
+      }
+      ThreadPool pool(threads);
+      for (size_t i = 0; i < n; ++i)
+        pool.submit([&task, i]() { task(i); });
+      pool.wait();
+    }
+  }
+
+  /*---------------------------------------------------
+    check property on opts.cases generated inputs
+    - chunks past the lowest failure found so far are
+      skipped, chunks below it always finish, so the
+      reported failure is the lowest failing case
+  */
+  template<typename G, typename P>
+  PropertyResult checkProperty(G gen, P property, const PropertyOptions& opts = PropertyOptions()) {
+    using T = typename G::value_type;
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    size_t chunk = std::max<size_t>(1, opts.chunk);
+    size_t nChunks = (opts.cases + chunk - 1) / chunk;
+    std::atomic<size_t> firstFailure{ none };
+    std::mutex mtx;
+    std::string failMessage;
+    size_t nThreads = opts.threads == 0 ? std::thread::hardware_concurrency() : opts.threads;
+    nThreads = std::max<size_t>(1, std::min(nThreads, nChunks));
+    detail::runTasks(nChunks, nThreads, [&](size_t c) {
+      size_t begin = c * chunk, end = std::min(opts.cases, begin + chunk);
+      if (begin > firstFailure.load())
+        return;
+      T value{};
+      P prop(property);
+      for (size_t i = begin; i < end && i < firstFailure.load(); ++i) {
+        Rng rng(Rng::caseSeed(opts.seed, i));
+        gen(rng, value);
+        std::string message;
+        if (!detail::holds(prop, static_cast<const T&>(value), message)) {
+          std::lock_guard<std::mutex> l(mtx);
+          if (i < firstFailure.load()) {
+            firstFailure = i;
+            failMessage = message;
+          }
+          return;
+        }
+      }
+    });
+    PropertyResult result;
+    result.seed = opts.seed;
+    if (firstFailure.load() == none) {
+      result.cases = opts.cases;
+      return result;
+    }
+    result.passed = false;
+    result.failingCase = firstFailure.load();
+    result.cases = result.failingCase + 1;
+    result.message = failMessage;
+
+    T failing{};
+    Rng rng(Rng::caseSeed(opts.seed, result.failingCase));
+    gen(rng, failing);
+    result.counterexample = describe(failing);
+    if constexpr (HasShrink<G>::value) {
+      bool progress = true;
+      while (progress && result.shrinkSteps < opts.maxShrinks) {
+        progress = false;
+        for (auto& candidate : gen.shrink(failing)) {
+          std::string message;
+          if (!detail::holds(property, static_cast<const T&>(candidate), message)) {
+            failing = std::move(candidate);
+            result.message = message;
+            ++result.shrinkSteps;
+            progress = true;
+            break;
+          }
+        }
+      }
+    }
+    result.shrunk = describe(failing);
+    return result;
+  }
+
+  inline void showProperty(const PropertyResult& r, std::ostream& out) {
+    if (r.passed) {
+      out << "\n  property held for " << r.cases << " cases";
+      return;
+    }
+    out << "\n  property falsified by case " << r.failingCase << ", seed " << r.seed;
+    out << "\n    counterexample: " << r.counterexample;
+    if (r.shrinkSteps > 0)
+      out << "\n    shrunk in " << r.shrinkSteps << " steps to: " << r.shrunk;
+    if (!r.message.empty())
+      out << "\n    " << r.message;
+  }
+  /*-- report property result as one note --*/
+  inline void showProperty(const PropertyResult& r, Reporter& reporter = defaultReporter()) {
+    std::ostringstream out;
+    showProperty(r, out);
+    noteLines(reporter, out.str());
+  }
+
+  /*-- "case N, seed S, counterexample C, shrunk in K steps to X, message" --*/
+  inline std::string describeFalsified(const PropertyResult& r) {
+    std::string text = "case " + std::to_string(r.failingCase) + ", seed " + std::to_string(r.seed)
+      + ", counterexample " + r.counterexample;
+    if (r.shrinkSteps > 0)
+      text += ", shrunk in " + std::to_string(r.shrinkSteps) + " steps to " + r.shrunk;
+    if (!r.message.empty())
+      text += ", " + r.message;
+    return text;
+  }
+
+  /*-- property test for TestSequencer::reg, records the counterexample as the failure --*/
+  template<typename G, typename P>
+  TestCallable forAll(G gen, P property, const PropertyOptions& opts = PropertyOptions()) {
+    return [gen = std::move(gen), property = std::move(property), opts]() {
+      PropertyResult r = checkProperty(gen, property, opts);
+      if (!r.passed)
+        return recordFailure("property", "forAll", "", 0, describeFalsified(r));
+      return true;
+    };
+  }
+
+  /*-- parameterised test for TestSequencer::reg, records every failing parameter as the failure --*/
+  template<typename T, typename B>
+  TestCallable forEach(std::vector<T> values, B body, size_t threads = 0) {
+    return [values = std::move(values), body = std::move(body), threads]() {
+      std::vector<char> failed(values.size(), 0);
+      std::vector<std::string> messages(values.size());
+      detail::runTasks(values.size(), threads, [&](size_t i) {
+        B b(body);
+        failed[i] = !detail::holds(b, values[i], messages[i]);
+      });
+      std::string text;
+      for (size_t i = 0; i < values.size(); ++i) {
+        if (!failed[i])
+          continue;
+        if (!text.empty())
+          text += "; ";
+        text += "parameter " + describe(values[i]);
+        if (!messages[i].empty())
+          text += ", " + messages[i];
+      }
+      if (!text.empty())
+        return recordFailure("parameter", "forEach", "", 0, text);
+      return true;
+    };
+  }
+}
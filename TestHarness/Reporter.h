@@ -0,0 +1,455 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Reporter.h - buffered display of test results           //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Formats test results and notes for an output stream:
+   - ConsoleReporter, the harness's familiar "name passed" text
+   - JsonLinesReporter, one JSON object per result or note
+   - JUnitReporter, a JUnit XML document written by finish()
+   - each thread formats into its own buffer, so concurrent
+     tests neither contend for the stream nor interleave
+     partial lines
+   - every record is numbered as it is reported, and buffers
+     are written merged in that order, so output of nested or
+     worker threads stays ahead of a later summary
+   - while a ReportBatch is open, e.g., during a test run,
+     buffers are written only when one holds batchBytes, or
+     when the batch closes, and the stream is flushed once per
+     batch; outside a batch every report is written at once
+   - noteLines() reports text formatted for the console, e.g.,
+     by showBenchmark, as one note
+   - defaultReporter() serves executors whose ExecutorOptions
+     name no reporter, useReporter() replaces it
+
+   Package Dependencies:
+  -----------------------
+   Reporter.h
+   TestResult.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.5 - 17 Oct 2026
+   - each reporter maps threads to their buffers, threads cache
+     only the last reporter used, so no per-thread table grows
+     with reporters created and destroyed
+   ver 1.4 - 17 Oct 2026
+   - JSON lines tell whether peak resident set was shared with
+     concurrent tests
+   ver 1.3 - 17 Oct 2026
+   - buffers are merged in report order, the stream is flushed
+     per batch, not per report
+   ver 1.2 - 17 Oct 2026
+   - console and JSON lines reporters show resource usage
+   ver 1.1 - 17 Oct 2026
+   - ConsoleReporter shows why a test failed
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include "TestResult.h"
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // Reporter class
+
+  class Reporter {
+  public:
+    explicit Reporter(std::ostream& out = std::cout, size_t batchBytes = 16 * 1024)
+      : out_(out), batchBytes_(batchBytes), id_(nextId()) {}
+    Reporter(const Reporter&) = delete;
+    Reporter& operator=(const Reporter&) = delete;
+    virtual ~Reporter() {}
+
+    /*-- display one test result --*/
+    void report(const TestResult& r, const ExecutorOptions& opts = ExecutorOptions()) {
+      Buffer& b = buffer();
+      std::unique_lock<std::mutex> l(b.mtx);
+      b.marks.push_back(Mark{ seq_++, b.text.size() });
+      formatResult(r, opts, b.text);
+      release(b, l);
+    }
+    /*-- display free text, e.g., a notice from the executor --*/
+    void note(const std::string& text) {
+      Buffer& b = buffer();
+      std::unique_lock<std::mutex> l(b.mtx);
+      b.marks.push_back(Mark{ seq_++, b.text.size() });
+      formatNote(text, b.text);
+      release(b, l);
+    }
+    /*-- write every thread's buffered text, in report order, and flush stream --*/
+    void flush() {
+      writeBuffered();
+      std::lock_guard<std::mutex> l(outMtx_);
+      out_.flush();
+    }
+    /*-- complete the report, e.g., close a document --*/
+    virtual void finish() {
+      flush();
+    }
+    void beginBatch() {
+      ++batches_;
+    }
+    void endBatch() {
+      if (--batches_ == 0)
+        flush();
+    }
+  protected:
+    virtual void formatResult(const TestResult& r, const ExecutorOptions& opts, std::string& out) = 0;
+    virtual void formatNote(const std::string& text, std::string& out) = 0;
+
+    /*-- called with output lock held, whole records only --*/
+    virtual void write(const std::string& text) {
+      out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    std::ostream& stream() {
+      return out_;
+    }
+  private:
+    /*-- where a record starts in its buffer's text --*/
+    struct Mark {
+      uint64_t seq;
+      size_t offset;
+    };
+    struct Buffer {
+      std::mutex mtx;
+      std::string text;
+      std::vector<Mark> marks;
+    };
+    static uint64_t nextId() {
+      static std::atomic<uint64_t> id{ 0 };
+      return ++id;
+    }
+    /*---------------------------------------------------
+      this thread's buffer, created on first use
+      - the thread caches its last reporter's buffer by
+        id, ids are never reused, so a stale cache entry
+        never matches
+    */
+    Buffer& buffer() {
+      struct Cached {
+        uint64_t id = 0;
+        Buffer* pB = nullptr;
+      };
+      thread_local Cached cached;
+      if (cached.id == id_)
+        return *cached.pB;
+      std::lock_guard<std::mutex> l(buffersMtx_);
+      Buffer*& pB = byThread_[std::this_thread::get_id()];
+      if (!pB) {
+        buffers_.push_back(std::make_unique<Buffer>());
+        pB = buffers_.back().get();
+      }
+      cached = Cached{ id_, pB };
+      return *pB;
+    }
+    /*-- write buffers now unless batching and this one is still small --*/
+    void release(Buffer& b, std::unique_lock<std::mutex>& l) {
+      if (batches_.load() > 0 && b.text.size() < batchBytes_)
+        return;
+      l.unlock();
+      writeBuffered();
+    }
+    /*---------------------------------------------------
+      write all buffered records merged by number
+      - holds every buffer's lock, so no record numbered
+        before the newest one written is still being
+        formatted
+    */
+    void writeBuffered() {
+      std::lock_guard<std::mutex> ol(outMtx_);
+      std::vector<Buffer*> buffers;
+      {
+        std::lock_guard<std::mutex> l(buffersMtx_);
+        for (auto& pB : buffers_)
+          buffers.push_back(pB.get());
+      }
+      std::vector<std::unique_lock<std::mutex>> locks;
+      locks.reserve(buffers.size());
+      struct Record {
+        uint64_t seq;
+        const std::string* pText;
+        size_t begin, end;
+      };
+      std::vector<Record> records;
+      for (Buffer* pB : buffers) {
+        locks.emplace_back(pB->mtx);
+        for (size_t i = 0; i < pB->marks.size(); ++i) {
+          size_t end = i + 1 < pB->marks.size() ? pB->marks[i + 1].offset : pB->text.size();
+          records.push_back(Record{ pB->marks[i].seq, &pB->text, pB->marks[i].offset, end });
+        }
+      }
+      if (records.empty())
+        return;
+      std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) { return a.seq < b.seq; });
+      std::string text;
+      for (auto& rec : records)
+        text.append(*rec.pText, rec.begin, rec.end - rec.begin);
+      write(text);
+      for (Buffer* pB : buffers) {
+        pB->text.clear();
+        pB->marks.clear();
+      }
+    }
+
+    std::ostream& out_;
+    size_t batchBytes_;
+    uint64_t id_;
+    std::atomic<int> batches_{ 0 };
+    std::atomic<uint64_t> seq_{ 0 };
+    std::mutex outMtx_;
+    std::mutex buffersMtx_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+    std::unordered_map<std::thread::id, Buffer*> byThread_;
+  };
+
+  /*-- buffers reports while in scope, e.g., for one test run --*/
+  class ReportBatch {
+  public:
+    explicit ReportBatch(Reporter& reporter) : reporter_(reporter) {
+      reporter_.beginBatch();
+    }
+    ReportBatch(const ReportBatch&) = delete;
+    ReportBatch& operator=(const ReportBatch&) = delete;
+    ~ReportBatch() {
+      reporter_.endBatch();
+    }
+  private:
+    Reporter& reporter_;
+  };
+
+  ///////////////////////////////////////////////
+  // ConsoleReporter class
+
+  class ConsoleReporter : public Reporter {
+  public:
+    using Reporter::Reporter;
+    ~ConsoleReporter() override {
+      flush();
+    }
+  protected:
+    void formatResult(const TestResult& r, const ExecutorOptions& opts, std::string& out) override {
+      out += "\n  ";
+      out += r.name;
+      if (r.timedOut)
+        out += " timed out";
+      else
+        out += r.passed ? " passed" : " failed";
+      if (!r.passed && !r.message.empty()) {
+        out += "\n    ";
+        out += r.message;
+      }
+      if (opts.counters || opts.allocations || opts.resources) {
+        std::ostringstream detail;
+        if (opts.counters)
+          showCounters(r.counters, detail);
+        if (opts.allocations)
+          showAllocStats(r.allocations, detail);
+        if (opts.resources)
+          showResourceUsage(r.resources, detail);
+        out += detail.str();
+      }
+    }
+    void formatNote(const std::string& text, std::string& out) override {
+      out += "\n  ";
+      out += text;
+    }
+  };
+
+  /*-- escape text for a JSON string or XML attribute --*/
+  inline void appendEscaped(std::string& out, const std::string& text, bool xml) {
+    for (unsigned char ch : text) {
+      if (xml) {
+        switch (ch) {
+        case '&': out += "&amp;"; continue;
+        case '<': out += "&lt;"; continue;
+        case '>': out += "&gt;"; continue;
+        case '"': out += "&quot;"; continue;
+        default: break;
+        }
+        if (ch < 0x20 && ch != '\t' && ch != '\n' && ch != '\r') {
+          out += '?';
+          continue;
+        }
+        out += static_cast<char>(ch);
+        continue;
+      }
+      switch (ch) {
+      case '"': out += "\\\""; continue;
+      case '\\': out += "\\\\"; continue;
+      case '\n': out += "\\n"; continue;
+      case '\r': out += "\\r"; continue;
+      case '\t': out += "\\t"; continue;
+      default: break;
+      }
+      if (ch < 0x20) {
+        char code[8];
+        std::snprintf(code, sizeof(code), "\\u%04x", ch);
+        out += code;
+        continue;
+      }
+      out += static_cast<char>(ch);
+    }
+  }
+
+  ///////////////////////////////////////////////
+  // JsonLinesReporter class
+
+  class JsonLinesReporter : public Reporter {
+  public:
+    using Reporter::Reporter;
+    ~JsonLinesReporter() override {
+      flush();
+    }
+  protected:
+    void formatResult(const TestResult& r, const ExecutorOptions& opts, std::string& out) override {
+      out += "{\"name\":\"";
+      appendEscaped(out, r.name, false);
+      out += "\",\"passed\":";
+      out += r.passed ? "true" : "false";
+      out += ",\"timed_out\":";
+      out += r.timedOut ? "true" : "false";
+      out += ",\"duration_ns\":" + std::to_string(r.duration().count());
+      out += ",\"cpu_ns\":" + std::to_string(r.cpuTime.count());
+      if (opts.allocations) {
+        out += ",\"allocations\":" + std::to_string(r.allocations.allocations);
+        out += ",\"bytes_allocated\":" + std::to_string(r.allocations.bytesAllocated);
+      }
+      if (opts.counters && r.counters.available) {
+        out += ",\"context_switches\":" + std::to_string(r.counters.contextSwitches);
+        out += ",\"page_faults\":" + std::to_string(r.counters.pageFaults);
+        if (r.counters.hardware) {
+          out += ",\"cycles\":" + std::to_string(r.counters.cycles);
+          out += ",\"instructions\":" + std::to_string(r.counters.instructions);
+        }
+      }
+      if (opts.resources && r.resources.available) {
+        out += ",\"peak_rss_bytes\":" + std::to_string(r.resources.peakRssBytes);
+        out += std::string(",\"peak_rss_concurrent\":") + (r.resources.concurrent ? "true" : "false");
+        out += ",\"rss_growth_bytes\":" + std::to_string(r.resources.rssGrowthBytes);
+        out += ",\"minor_faults\":" + std::to_string(r.resources.minorFaults);
+        out += ",\"major_faults\":" + std::to_string(r.resources.majorFaults);
+        out += ",\"voluntary_switches\":" + std::to_string(r.resources.voluntarySwitches);
+        out += ",\"involuntary_switches\":" + std::to_string(r.resources.involuntarySwitches);
+      }
+      out += ",\"message\":\"";
+      appendEscaped(out, r.message, false);
+      out += "\"}\n";
+    }
+    void formatNote(const std::string& text, std::string& out) override {
+      out += "{\"note\":\"";
+      appendEscaped(out, text, false);
+      out += "\"}\n";
+    }
+  };
+
+  ///////////////////////////////////////////////
+  // JUnitReporter class
+
+  class JUnitReporter : public Reporter {
+  public:
+    explicit JUnitReporter(std::ostream& out, const std::string& suite = "TestHarness", size_t batchBytes = 16 * 1024)
+      : Reporter(out, batchBytes), suite_(suite) {}
+    ~JUnitReporter() override {
+      finish();
+    }
+    /*-- write the document, once, after the last result --*/
+    void finish() override {
+      flush();
+      std::lock_guard<std::mutex> l(docMtx_);
+      if (finished_)
+        return;
+      finished_ = true;
+      std::ostream& out = stream();
+      out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+      std::string suite;
+      appendEscaped(suite, suite_, true);
+      out << "<testsuite name=\"" << suite << "\" tests=\"" << tests_.load()
+        << "\" failures=\"" << failures_.load() << "\">\n" << cases_ << "</testsuite>\n";
+      out.flush();
+    }
+  protected:
+    void formatResult(const TestResult& r, const ExecutorOptions&, std::string& out) override {
+      ++tests_;
+      out += "  <testcase name=\"";
+      appendEscaped(out, r.name, true);
+      out += "\" time=\"" + std::to_string(std::chrono::duration<double>(r.duration()).count()) + "\"";
+      if (r.passed) {
+        out += "/>\n";
+        return;
+      }
+      ++failures_;
+      out += ">\n    <failure message=\"";
+      std::string why = r.timedOut ? "timed out" : "failed";
+      if (!r.message.empty())
+        why += ": " + r.message;
+      appendEscaped(out, why, true);
+      out += "\"/>\n  </testcase>\n";
+    }
+    /*-- notes repeat what results record, so they're left out --*/
+    void formatNote(const std::string&, std::string&) override {}
+
+    /*-- testcases are kept until finish() wraps them in a testsuite --*/
+    void write(const std::string& text) override {
+      std::lock_guard<std::mutex> l(docMtx_);
+      cases_ += text;
+    }
+  private:
+    std::string suite_;
+    std::atomic<size_t> tests_{ 0 };
+    std::atomic<size_t> failures_{ 0 };
+    std::mutex docMtx_;
+    std::string cases_;
+    bool finished_ = false;
+  };
+
+  /*-- "console", "jsonl", or "junit", throws std::invalid_argument otherwise --*/
+  inline std::shared_ptr<Reporter> makeReporter(const std::string& kind, std::ostream& out = std::cout) {
+    if (kind == "console")
+      return std::make_shared<ConsoleReporter>(out);
+    if (kind == "jsonl")
+      return std::make_shared<JsonLinesReporter>(out);
+    if (kind == "junit")
+      return std::make_shared<JUnitReporter>(out);
+    throw std::invalid_argument("unknown reporter " + kind + ", expected console, jsonl, or junit");
+  }
+
+  namespace detail {
+    inline std::shared_ptr<Reporter>& defaultReporterSlot() {
+      static std::shared_ptr<Reporter> pReporter = std::make_shared<ConsoleReporter>();
+      return pReporter;
+    }
+  }
+
+  /*-- reporter used when ExecutorOptions names none --*/
+  inline Reporter& defaultReporter() {
+    return *detail::defaultReporterSlot();
+  }
+  /*-- replace default reporter, finishing the old one, call between test runs --*/
+  inline void useReporter(std::shared_ptr<Reporter> pReporter) {
+    std::shared_ptr<Reporter>& slot = detail::defaultReporterSlot();
+    slot->finish();
+    slot = std::move(pReporter);
+  }
+  /*-- report lines formatted for the console, each starting "\n  ", as one note --*/
+  inline void noteLines(Reporter& reporter, const std::string& lines) {
+    reporter.note(lines.compare(0, 3, "\n  ") == 0 ? lines.substr(3) : lines);
+  }
+}
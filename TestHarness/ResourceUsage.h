@@ -0,0 +1,284 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// ResourceUsage.h - per-test memory footprint and faults  //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Measures what a test costs the operating system, so memory
+   blow-ups show up in the test that causes them:
+   - ResourceUsage holds peak resident set above the resident
+     set at start, resident set growth, minor and major page
+     faults, and voluntary and involuntary context switches
+   - ResourceMeter takes a snapshot at start() and returns the
+     differences at stop()
+
+   Linux:
+   - faults and switches come from getrusage(RUSAGE_THREAD), so
+     they count only the calling thread
+   - resident set comes from /proc/self/statm; start() resets
+     the kernel's peak by writing 5 to /proc/self/clear_refs and
+     stop() reads the new peak, VmHWM, from /proc/self/status
+   - if the peak can't be reset, peak is the growth of the
+     process lifetime peak, ru_maxrss, so a test that stays
+     below an earlier test's peak reports zero
+   Windows:
+   - GetProcessMemoryInfo gives working set, lifetime peak, and
+     page faults of the whole process, faults are all counted
+     as minor and context switches are not available
+   Other platforms:
+   - getrusage(RUSAGE_SELF) gives process faults, switches, and
+     lifetime peak, resident set growth is not available
+
+   Resident set is a process wide measure.  A meter running while
+   another is, e.g., in a parallel run, never resets the kernel's
+   peak, since that would spoil the other test's peak, and marks
+   its usage concurrent: peak is lifetime peak growth, which may
+   include the other tests' memory, and executors don't check it
+   against a limit.
+
+   Package Dependencies:
+  -----------------------
+   ResourceUsage.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.2 - 17 Oct 2026
+   - start() reads the overlap count before joining the active
+     meters, so a meter starting in between isn't missed
+   ver 1.1 - 17 Oct 2026
+   - overlapping meters don't reset the peak, usage is marked
+     concurrent
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <sys/resource.h>
+  #include <sys/time.h>
+  #ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cstring>
+    #include <cstdlib>
+  #endif
+#endif
+
+namespace Test {
+
+  struct ResourceUsage {
+    bool available = false;
+    bool exactPeak = false;         // peak measured from this test's start
+    bool concurrent = false;        // other meters ran meanwhile, peak may include their tests
+    long long peakRssBytes = 0;     // peak resident set above start
+    long long rssGrowthBytes = 0;   // resident set at stop minus start
+    uint64_t minorFaults = 0;
+    uint64_t majorFaults = 0;
+    uint64_t voluntarySwitches = 0;
+    uint64_t involuntarySwitches = 0;
+  };
+
+  /*-- display usage on one indented line --*/
+  inline void showResourceUsage(const ResourceUsage& u, std::ostream& out = std::cout) {
+    if (!u.available) {
+      out << "\n    resource usage unavailable";
+      return;
+    }
+    out << "\n    peak rss +" << u.peakRssBytes / 1024 << " KB"
+      << (u.concurrent ? " (shared with concurrent tests)" : u.exactPeak ? "" : " (lifetime peak)")
+      << ", rss growth " << u.rssGrowthBytes / 1024 << " KB"
+      << ", faults " << u.minorFaults << " minor, " << u.majorFaults << " major"
+      << ", switches " << u.voluntarySwitches << " voluntary, " << u.involuntarySwitches << " involuntary";
+  }
+
+  ///////////////////////////////////////////////
+  // ResourceMeter class
+
+  class ResourceMeter {
+  public:
+    ResourceMeter() = default;
+    ResourceMeter(const ResourceMeter&) = delete;
+    ResourceMeter& operator=(const ResourceMeter&) = delete;
+    ~ResourceMeter() {
+      if (running_)
+        leave();
+    }
+    /*-- snapshot usage, resetting the kernel's peak if no other meter runs --*/
+    void start() {
+      start_ = Snapshot();
+      running_ = true;
+      epoch_ = overlaps().load();   // before joining, so a meter starting in between is seen
+      bool alone = active().fetch_add(1) == 0;
+      if (!alone)
+        ++overlaps();   // tells meters already running that they overlap
+      concurrent_ = !alone;
+#if defined(__linux__)
+      exactPeak_ = alone && resetPeak();
+#endif
+      start_ = take();
+    }
+    /*-- usage since start() --*/
+    ResourceUsage stop() {
+      Snapshot end = take();
+      bool concurrent = concurrent_ || overlaps().load() != epoch_;
+      if (running_)
+        leave();
+      ResourceUsage u;
+      if (!start_.valid || !end.valid)
+        return u;
+      u.available = true;
+      u.concurrent = concurrent;
+      u.rssGrowthBytes = end.rss - start_.rss;
+      u.minorFaults = end.minorFaults - start_.minorFaults;
+      u.majorFaults = end.majorFaults - start_.majorFaults;
+      u.voluntarySwitches = end.voluntarySwitches - start_.voluntarySwitches;
+      u.involuntarySwitches = end.involuntarySwitches - start_.involuntarySwitches;
+      long long peak = 0;
+#if defined(__linux__)
+      long long hwm = exactPeak_ && !concurrent ? statusKb("VmHWM:") * 1024 : -1;
+      if (hwm >= 0) {
+        u.exactPeak = true;
+        peak = hwm - start_.rss;
+      }
+      else
+        peak = end.peak - start_.peak;
+#else
+      peak = end.peak - start_.peak;
+#endif
+      u.peakRssBytes = std::max({ 0LL, peak, u.rssGrowthBytes });
+      return u;
+    }
+  private:
+    /*-- meters between start() and stop(), process wide --*/
+    static std::atomic<int>& active() {
+      static std::atomic<int> count{ 0 };
+      return count;
+    }
+    /*-- starts that found another meter running --*/
+    static std::atomic<uint64_t>& overlaps() {
+      static std::atomic<uint64_t> count{ 0 };
+      return count;
+    }
+    void leave() {
+      running_ = false;
+      --active();
+    }
+
+    struct Snapshot {
+      bool valid = false;
+      long long rss = 0;              // bytes
+      long long peak = 0;             // process lifetime peak, bytes
+      uint64_t minorFaults = 0;
+      uint64_t majorFaults = 0;
+      uint64_t voluntarySwitches = 0;
+      uint64_t involuntarySwitches = 0;
+    };
+
+#if defined(_WIN32)
+
+    static Snapshot take() {
+      Snapshot s;
+      PROCESS_MEMORY_COUNTERS pmc{};
+      if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return s;
+      s.valid = true;
+      s.rss = static_cast<long long>(pmc.WorkingSetSize);
+      s.peak = static_cast<long long>(pmc.PeakWorkingSetSize);
+      s.minorFaults = pmc.PageFaultCount;
+      return s;
+    }
+
+#else
+
+    static Snapshot take() {
+      Snapshot s;
+      rusage ru{};
+#if defined(__linux__)
+      if (getrusage(RUSAGE_THREAD, &ru) != 0)
+        return s;
+      rusage self{};
+      getrusage(RUSAGE_SELF, &self);
+      s.peak = static_cast<long long>(self.ru_maxrss) * 1024;   // kilobytes on Linux
+      s.rss = residentPages() * sysconf(_SC_PAGESIZE);
+#else
+      if (getrusage(RUSAGE_SELF, &ru) != 0)
+        return s;
+  #if defined(__APPLE__)
+      s.peak = static_cast<long long>(ru.ru_maxrss);            // bytes on macOS
+  #else
+      s.peak = static_cast<long long>(ru.ru_maxrss) * 1024;
+  #endif
+#endif
+      s.valid = true;
+      s.minorFaults = static_cast<uint64_t>(ru.ru_minflt);
+      s.majorFaults = static_cast<uint64_t>(ru.ru_majflt);
+      s.voluntarySwitches = static_cast<uint64_t>(ru.ru_nvcsw);
+      s.involuntarySwitches = static_cast<uint64_t>(ru.ru_nivcsw);
+      return s;
+    }
+
+#endif
+
+#if defined(__linux__)
+
+    /*-- read small /proc file without allocating, returns bytes read --*/
+    static size_t readProc(const char* path, char* buf, size_t size) {
+      int fd = ::open(path, O_RDONLY);
+      if (fd < 0)
+        return 0;
+      ssize_t n = ::read(fd, buf, size - 1);
+      ::close(fd);
+      buf[n > 0 ? n : 0] = '\0';
+      return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+    /*-- second field of /proc/self/statm --*/
+    static long long residentPages() {
+      char buf[128];
+      if (readProc("/proc/self/statm", buf, sizeof(buf)) == 0)
+        return 0;
+      char* next = nullptr;
+      std::strtoll(buf, &next, 10);
+      return std::strtoll(next, nullptr, 10);
+    }
+    /*-- kilobytes on the line of /proc/self/status starting with key, -1 if absent --*/
+    static long long statusKb(const char* key) {
+      char buf[4096];
+      if (readProc("/proc/self/status", buf, sizeof(buf)) == 0)
+        return -1;
+      const char* line = std::strstr(buf, key);
+      if (!line)
+        return -1;
+      return std::strtoll(line + std::strlen(key), nullptr, 10);
+    }
+    /*-- make VmHWM the current resident set, needs Linux 4.0 --*/
+    static bool resetPeak() {
+      int fd = ::open("/proc/self/clear_refs", O_WRONLY);
+      if (fd < 0)
+        return false;
+      bool ok = ::write(fd, "5", 1) == 1;
+      ::close(fd);
+      return ok;
+    }
+
+    bool exactPeak_ = false;
+
+#endif
+
+    Snapshot start_;
+    bool running_ = false;
+    bool concurrent_ = false;
+    uint64_t epoch_ = 0;
+  };
+}
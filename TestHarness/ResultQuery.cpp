@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////
+// ResultQuery.cpp - query tool for ResultStore files          //
+//                                                             //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ     //
+/////////////////////////////////////////////////////////////////
+/*
+   Build with TEST_RESULTQUERY defined to get a command line
+   tool that maps a result store, see ResultStore.h:
+
+     ResultQuery <store> [--run=N] [--failures] [--slowest=N]
+                         [--diff[=<other store>]]
+
+   With no query it summarizes the run.  --run picks the run,
+   default the last.  --diff compares with the previous run of
+   the same store, or with the last run of another store.
+*/
+
+#include "ResultStore.h"
+#include "TestClock.h"
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+#ifdef TEST_RESULTQUERY
+
+using namespace Test;
+
+namespace {
+
+  std::string optionValue(const std::string& arg) {
+    size_t eq = arg.find('=');
+    return eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+  }
+
+  void showRecord(const ResultStore& store, const StoredResult& r) {
+    std::cout << "\n  " << store.name(r) << (r.timedOut ? " timed out" : r.passed ? " passed" : " failed")
+      << ", " << r.durationNs / 1000.0 << " us";
+  }
+
+  const char* describe(ResultStore::Change::Kind kind) {
+    switch (kind) {
+    case ResultStore::Change::nowFails: return "now fails";
+    case ResultStore::Change::nowPasses: return "now passes";
+    case ResultStore::Change::added: return "added";
+    default: return "removed";
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+
+  if (argc < 2) {
+    std::cout << "\n  usage: ResultQuery <store> [--run=N] [--failures] [--slowest=N] [--diff[=<other store>]]\n";
+    return 1;
+  }
+  auto start = Clock::now();
+  ResultStore store;
+  if (!store.open(argv[1])) {
+    std::cout << "\n  can't open result store " << argv[1] << "\n";
+    return 1;
+  }
+  uint32_t run = store.lastRun();
+  bool failures = false, diff = false;
+  size_t slowest = 0;
+  std::string other;
+  try {
+    for (int i = 2; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg.rfind("--run=", 0) == 0)
+        run = static_cast<uint32_t>(std::stoul(optionValue(arg)));
+      else if (arg == "--failures")
+        failures = true;
+      else if (arg.rfind("--slowest=", 0) == 0)
+        slowest = std::stoul(optionValue(arg));
+      else if (arg == "--diff" || arg.rfind("--diff=", 0) == 0) {
+        diff = true;
+        other = optionValue(arg);
+      }
+      else
+        throw std::invalid_argument("unknown option " + arg);
+    }
+  }
+  catch (std::exception& ex) {
+    std::cout << "\n  " << ex.what() << "\n";
+    return 1;
+  }
+
+  ResultStore::Range range = store.run(run);
+  std::cout << "\n  " << argv[1] << ": " << store.lastRun() << " runs, " << store.size() << " records";
+  std::cout << "\n  run " << run << ": " << range.size() << " tests, " << store.failures(range).size() << " failed";
+
+  if (failures) {
+    std::cout << "\n\n  failures:";
+    for (const StoredResult* p : store.failures(range))
+      showRecord(store, *p);
+  }
+  if (slowest > 0) {
+    std::cout << "\n\n  slowest " << slowest << ":";
+    for (const StoredResult* p : store.slowest(range, slowest))
+      showRecord(store, *p);
+  }
+  if (diff) {
+    ResultStore otherStore;
+    const ResultStore* pBefore = &store;
+    ResultStore::Range before = store.run(run - 1);
+    if (!other.empty()) {
+      if (!otherStore.open(other)) {
+        std::cout << "\n  can't open result store " << other << "\n";
+        return 1;
+      }
+      pBefore = &otherStore;
+      before = otherStore.run(otherStore.lastRun());
+    }
+    auto changes = store.diff(range, *pBefore, before);
+    std::cout << "\n\n  " << changes.size() << " changes:";
+    for (auto& c : changes)
+      std::cout << "\n  " << c.name << " " << describe(c.kind);
+  }
+  std::cout << "\n\n  query took " << microseconds(Clock::now() - start) / 1000 << " ms\n";
+}
+#endif
@@ -0,0 +1,532 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// ResultStore.h - compact binary store of test results    //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Keeps the results of very large suites, e.g., millions of
+   parameterised cases, in two append-only files:
+   - <path> holds fixed size StoredResult records, so record i
+     is at a known offset and a mapped file is an array
+   - <path>.names is the interned name table, each name is
+     written once, the first time any run sees it, and records
+     refer to it by offset
+   - every ResultStoreWriter session is one run, numbered one
+     more than the last run in the file, so runs are contiguous
+     and in order
+   - ResultStore maps both files read-only and answers queries,
+     failures, slowest n, and the difference between two runs,
+     without parsing or copying the file
+
+   Names are flushed before the records that refer to them, so
+   a crash leaves at most an incomplete last record, which the
+   reader ignores.
+
+   File formats, integers in native byte order:
+     <path>        header, then StoredResult records
+     <path>.names  header, then { uint32 length, chars } entries
+     header        8 byte magic, uint32 version, uint32 record size
+
+   Package Dependencies:
+  -----------------------
+   ResultStore.h
+   TestResult.h
+   Sharding.h (stableHash)
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include "TestResult.h"
+#include "Sharding.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace Test {
+
+  /*-- one test execution, as stored --*/
+  struct StoredResult {
+    uint64_t name;          // offset of name in the name table
+    uint64_t durationNs;
+    uint64_t cpuNs;
+    uint32_t run;
+    uint8_t passed;
+    uint8_t timedOut;
+    uint16_t reserved;
+  };
+  static_assert(sizeof(StoredResult) == 32, "StoredResult must stay 32 bytes");
+
+  namespace detail {
+    struct StoreHeader {
+      char magic[8];
+      uint32_t version;
+      uint32_t recordSize;
+    };
+    constexpr char recordsMagic[8] = { 'T', 'H', 'R', 'E', 'S', 'U', 'L', 'T' };
+    constexpr char namesMagic[8] = { 'T', 'H', 'N', 'A', 'M', 'E', 'S', '\0' };
+    constexpr uint32_t storeVersion = 1;
+
+    inline StoreHeader makeHeader(const char (&magic)[8], uint32_t recordSize) {
+      StoreHeader h{};
+      std::memcpy(h.magic, magic, sizeof(h.magic));
+      h.version = storeVersion;
+      h.recordSize = recordSize;
+      return h;
+    }
+    inline bool validHeader(const char* data, size_t size, const char (&magic)[8], uint32_t recordSize) {
+      if (size < sizeof(StoreHeader))
+        return false;
+      StoreHeader h;
+      std::memcpy(&h, data, sizeof(h));
+      return std::memcmp(h.magic, magic, sizeof(h.magic)) == 0
+        && h.version == storeVersion && h.recordSize == recordSize;
+    }
+    inline std::string namesPath(const std::string& path) {
+      return path + ".names";
+    }
+    /*-- 64 bit seek, stores outgrow long on Windows --*/
+    inline bool seek(std::FILE* pF, uint64_t pos) {
+#ifdef _WIN32
+      return _fseeki64(pF, static_cast<long long>(pos), SEEK_SET) == 0;
+#else
+      return fseeko(pF, static_cast<off_t>(pos), SEEK_SET) == 0;
+#endif
+    }
+  }
+
+  ///////////////////////////////////////////////
+  // MappedFile class - read-only file mapping
+
+  class MappedFile {
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+      close();
+    }
+    /*-- map whole file, returns false if it can't be opened --*/
+    bool open(const std::string& path) {
+      close();
+#ifdef _WIN32
+      file_ = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+      );
+      if (file_ == INVALID_HANDLE_VALUE)
+        return false;
+      LARGE_INTEGER size;
+      if (!GetFileSizeEx(file_, &size)) {
+        close();
+        return false;
+      }
+      size_ = static_cast<size_t>(size.QuadPart);
+      if (size_ == 0)
+        return true;
+      mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping_)
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+#else
+      fd_ = ::open(path.c_str(), O_RDONLY);
+      if (fd_ < 0)
+        return false;
+      struct stat st;
+      if (fstat(fd_, &st) != 0) {
+        close();
+        return false;
+      }
+      size_ = static_cast<size_t>(st.st_size);
+      if (size_ == 0)
+        return true;
+      void* p = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+      if (p != MAP_FAILED) {
+        data_ = static_cast<const char*>(p);
+        madvise(p, size_, MADV_SEQUENTIAL);
+      }
+#endif
+      if (!data_) {
+        close();
+        return false;
+      }
+      return true;
+    }
+    void close() {
+#ifdef _WIN32
+      if (data_)
+        UnmapViewOfFile(data_);
+      if (mapping_)
+        CloseHandle(mapping_);
+      if (file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_);
+      mapping_ = nullptr;
+      file_ = INVALID_HANDLE_VALUE;
+#else
+      if (data_)
+        munmap(const_cast<char*>(data_), size_);
+      if (fd_ >= 0)
+        ::close(fd_);
+      fd_ = -1;
+#endif
+      data_ = nullptr;
+      size_ = 0;
+    }
+    const char* data() const {
+      return data_;
+    }
+    size_t size() const {
+      return size_;
+    }
+  private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+  };
+
+  ///////////////////////////////////////////////
+  // ResultStoreWriter class - appends one run
+
+  class ResultStoreWriter {
+  public:
+    static constexpr size_t bufferedRecords = 32 * 1024;
+
+    ResultStoreWriter() = default;
+    ResultStoreWriter(const ResultStoreWriter&) = delete;
+    ResultStoreWriter& operator=(const ResultStoreWriter&) = delete;
+    ~ResultStoreWriter() {
+      close();
+    }
+    /*---------------------------------------------------
+      open store for appending a new run, creating it if
+      needed
+      - returns false if either file can't be opened or
+        isn't a result store
+    */
+    bool open(const std::string& path) {
+      close();
+      if (!loadNames(path) || !openRecords(path)) {
+        close();
+        return false;
+      }
+      return true;
+    }
+    /*-- number of this run, one more than the last stored --*/
+    uint32_t run() const {
+      return run_;
+    }
+    void append(const TestResult& r) {
+      StoredResult rec{};
+      rec.name = intern(r.name);
+      rec.durationNs = static_cast<uint64_t>(r.duration().count());
+      rec.cpuNs = static_cast<uint64_t>(r.cpuTime.count());
+      rec.run = run_;
+      rec.passed = r.passed ? 1 : 0;
+      rec.timedOut = r.timedOut ? 1 : 0;
+      buffer_.push_back(rec);
+      if (buffer_.size() >= bufferedRecords)
+        flush();
+    }
+    void append(const TestResults& results) {
+      for (auto& r : results)
+        append(r);
+    }
+    /*-- write buffered records, after the names they use --*/
+    void flush() {
+      if (!pRecords_)
+        return;
+      std::fflush(pNames_);
+      if (!buffer_.empty())
+        std::fwrite(buffer_.data(), sizeof(StoredResult), buffer_.size(), pRecords_);
+      buffer_.clear();
+      std::fflush(pRecords_);
+    }
+    void close() {
+      flush();
+      if (pRecords_)
+        std::fclose(pRecords_);
+      if (pNames_)
+        std::fclose(pNames_);
+      pRecords_ = pNames_ = nullptr;
+      names_.clear();
+      index_.clear();
+    }
+  private:
+    /*-- read existing name table, so names stay interned across runs --*/
+    bool loadNames(const std::string& path) {
+      std::string file = detail::namesPath(path);
+      MappedFile mapped;
+      if (mapped.open(file) && mapped.size() > 0) {
+        if (!detail::validHeader(mapped.data(), mapped.size(), detail::namesMagic, 0))
+          return false;
+        names_.assign(mapped.data(), mapped.size());
+      }
+      else {
+        detail::StoreHeader h = detail::makeHeader(detail::namesMagic, 0);
+        names_.assign(reinterpret_cast<const char*>(&h), sizeof(h));
+        if (std::FILE* pF = std::fopen(file.c_str(), "wb")) {
+          std::fwrite(&h, sizeof(h), 1, pF);
+          std::fclose(pF);
+        }
+      }
+      size_t pos = sizeof(detail::StoreHeader);
+      while (pos + sizeof(uint32_t) <= names_.size()) {
+        uint32_t length;
+        std::memcpy(&length, names_.data() + pos, sizeof(length));
+        if (pos + sizeof(length) + length > names_.size())
+          break;
+        index(std::string_view(names_.data() + pos + sizeof(length), length), pos);
+        pos += sizeof(length) + length;
+      }
+      names_.resize(pos);   // drop a partly written last name
+      pNames_ = std::fopen(file.c_str(), "r+b");
+      if (!pNames_)
+        return false;
+      return detail::seek(pNames_, pos);
+    }
+    /*-- find next run number and position after last whole record --*/
+    bool openRecords(const std::string& path) {
+      uint64_t records = 0;
+      MappedFile mapped;
+      if (mapped.open(path) && mapped.size() > 0) {
+        if (!detail::validHeader(mapped.data(), mapped.size(), detail::recordsMagic, sizeof(StoredResult)))
+          return false;
+        records = (mapped.size() - sizeof(detail::StoreHeader)) / sizeof(StoredResult);
+        run_ = 1;
+        if (records > 0) {
+          StoredResult last;
+          std::memcpy(
+            &last, mapped.data() + sizeof(detail::StoreHeader) + (records - 1) * sizeof(StoredResult), sizeof(last)
+          );
+          run_ = last.run + 1;
+        }
+        mapped.close();
+        pRecords_ = std::fopen(path.c_str(), "r+b");
+      }
+      else {
+        run_ = 1;
+        pRecords_ = std::fopen(path.c_str(), "wb");
+        if (pRecords_) {
+          detail::StoreHeader h = detail::makeHeader(detail::recordsMagic, sizeof(StoredResult));
+          std::fwrite(&h, sizeof(h), 1, pRecords_);
+        }
+      }
+      if (!pRecords_)
+        return false;
+      buffer_.reserve(bufferedRecords);
+      return detail::seek(pRecords_, sizeof(detail::StoreHeader) + records * sizeof(StoredResult));
+    }
+    /*-- map hash to offset, probing past the rare collision --*/
+    void index(std::string_view name, uint64_t offset) {
+      uint64_t h = stableHash(std::string(name));
+      while (index_.count(h))
+        ++h;
+      index_[h] = offset;
+    }
+    uint64_t intern(const std::string& name) {
+      uint64_t h = stableHash(name);
+      for (auto iter = index_.find(h); iter != index_.end(); iter = index_.find(++h)) {
+        uint32_t length;
+        std::memcpy(&length, names_.data() + iter->second, sizeof(length));
+        if (std::string_view(names_.data() + iter->second + sizeof(length), length) == name)
+          return iter->second;
+      }
+      uint64_t offset = names_.size();
+      uint32_t length = static_cast<uint32_t>(name.size());
+      names_.append(reinterpret_cast<const char*>(&length), sizeof(length));
+      names_.append(name);
+      std::fwrite(&length, sizeof(length), 1, pNames_);
+      std::fwrite(name.data(), 1, name.size(), pNames_);
+      index_[h] = offset;
+      return offset;
+    }
+
+    std::FILE* pRecords_ = nullptr;
+    std::FILE* pNames_ = nullptr;
+    uint32_t run_ = 0;
+    std::string names_;                          // copy of the name table
+    std::unordered_map<uint64_t, uint64_t> index_;  // name hash -> offset
+    std::vector<StoredResult> buffer_;
+  };
+
+  ///////////////////////////////////////////////
+  // ResultStore class - mapped, read-only queries
+
+  class ResultStore {
+  public:
+    /*-- first and one past last record of one run --*/
+    struct Range {
+      const StoredResult* begin = nullptr;
+      const StoredResult* end = nullptr;
+      size_t size() const {
+        return static_cast<size_t>(end - begin);
+      }
+    };
+    /*-- a test whose result differs between two runs --*/
+    struct Change {
+      std::string_view name;
+      enum Kind { nowFails, nowPasses, added, removed } kind;
+      const StoredResult* pNow;      // null if removed
+      const StoredResult* pBefore;   // null if added
+    };
+
+    /*-- map store, returns false if it's missing or not a result store --*/
+    bool open(const std::string& path) {
+      if (!records_.open(path) || !names_.open(detail::namesPath(path)))
+        return false;
+      if (!detail::validHeader(records_.data(), records_.size(), detail::recordsMagic, sizeof(StoredResult)))
+        return false;
+      if (!detail::validHeader(names_.data(), names_.size(), detail::namesMagic, 0))
+        return false;
+      size_ = (records_.size() - sizeof(detail::StoreHeader)) / sizeof(StoredResult);
+      return true;
+    }
+    /*-- number of records, all runs --*/
+    size_t size() const {
+      return size_;
+    }
+    const StoredResult* begin() const {
+      return reinterpret_cast<const StoredResult*>(records_.data() + sizeof(detail::StoreHeader));
+    }
+    const StoredResult* end() const {
+      return begin() + size_;
+    }
+    /*-- number of the last run, zero if store is empty --*/
+    uint32_t lastRun() const {
+      return size_ == 0 ? 0 : end()[-1].run;
+    }
+    /*-- records of one run, empty if there is no such run --*/
+    Range run(uint32_t n) const {
+      auto lo = std::lower_bound(begin(), end(), n, [](const StoredResult& r, uint32_t n) { return r.run < n; });
+      auto hi = std::upper_bound(lo, end(), n, [](uint32_t n, const StoredResult& r) { return n < r.run; });
+      return Range{ lo, hi };
+    }
+    /*-- name of record, "?" if the name table is incomplete --*/
+    std::string_view name(const StoredResult& r) const {
+      uint32_t length;
+      if (r.name + sizeof(length) > names_.size())
+        return "?";
+      std::memcpy(&length, names_.data() + r.name, sizeof(length));
+      if (r.name + sizeof(length) + length > names_.size())
+        return "?";
+      return std::string_view(names_.data() + r.name + sizeof(length), length);
+    }
+    std::vector<const StoredResult*> failures(Range range) const {
+      std::vector<const StoredResult*> failed;
+      for (const StoredResult* p = range.begin; p != range.end; ++p)
+        if (!p->passed)
+          failed.push_back(p);
+      return failed;
+    }
+    /*-- the n longest running records, longest first --*/
+    std::vector<const StoredResult*> slowest(Range range, size_t n) const {
+      auto longer = [](const StoredResult* a, const StoredResult* b) { return a->durationNs > b->durationNs; };
+      std::vector<const StoredResult*> heap;   // min-heap of the n longest seen
+      heap.reserve(n + 1);
+      for (const StoredResult* p = range.begin; p != range.end && n > 0; ++p) {
+        if (heap.size() == n && p->durationNs <= heap.front()->durationNs)
+          continue;
+        heap.push_back(p);
+        std::push_heap(heap.begin(), heap.end(), longer);
+        if (heap.size() > n) {
+          std::pop_heap(heap.begin(), heap.end(), longer);
+          heap.pop_back();
+        }
+      }
+      std::sort_heap(heap.begin(), heap.end(), longer);
+      return heap;
+    }
+    /*---------------------------------------------------
+      tests whose result in range now differs from their
+      result in range before of store beforeStore, which
+      may be this store
+      - runs usually list tests in the same order, so the
+        common prefix is compared in place, and only the
+        rest is matched by name
+      - within one store names are matched by offset, as
+        the name table holds each name once
+    */
+    std::vector<Change> diff(Range now, const ResultStore& beforeStore, Range before) const {
+      std::vector<Change> changes;
+      bool sameStore = &beforeStore == this;
+      auto sameName = [&](const StoredResult& a, const StoredResult& b) {
+        return sameStore ? a.name == b.name : name(a) == beforeStore.name(b);
+      };
+      while (now.begin != now.end && before.begin != before.end && sameName(*now.begin, *before.begin)) {
+        if (now.begin->passed != before.begin->passed) {
+          Change::Kind kind = now.begin->passed ? Change::nowPasses : Change::nowFails;
+          changes.push_back(Change{ name(*now.begin), kind, now.begin, before.begin });
+        }
+        ++now.begin;
+        ++before.begin;
+      }
+      if (sameStore)
+        matchRest(changes, now, before, [](const ResultStore&, const StoredResult& r) { return r.name; });
+      else
+        matchRest(changes, now, beforeStore, before, [](const ResultStore& s, const StoredResult& r) { return s.name(r); });
+      return changes;
+    }
+  private:
+    /*-- match records of two ranges by key(store, record) --*/
+    template<typename Key>
+    void matchRest(std::vector<Change>& changes, Range now, Range before, Key key) const {
+      matchRest(changes, now, *this, before, key);
+    }
+    template<typename Key>
+    void matchRest(
+      std::vector<Change>& changes, Range now, const ResultStore& beforeStore, Range before, Key key
+    ) const {
+      using K = decltype(key(*this, *now.begin));
+      std::unordered_map<K, const StoredResult*> was;
+      was.reserve(before.size());
+      for (const StoredResult* p = before.begin; p != before.end; ++p)
+        was[key(beforeStore, *p)] = p;
+      for (const StoredResult* p = now.begin; p != now.end; ++p) {
+        auto iter = was.find(key(*this, *p));
+        if (iter == was.end()) {
+          changes.push_back(Change{ name(*p), Change::added, p, nullptr });
+          continue;
+        }
+        if (iter->second && iter->second->passed != p->passed)
+          changes.push_back(Change{ name(*p), p->passed ? Change::nowPasses : Change::nowFails, p, iter->second });
+        iter->second = nullptr;
+      }
+      for (const StoredResult* p = before.begin; p != before.end; ++p) {
+        auto iter = was.find(key(beforeStore, *p));
+        if (iter != was.end() && iter->second) {
+          changes.push_back(Change{ beforeStore.name(*p), Change::removed, nullptr, p });
+          iter->second = nullptr;
+        }
+      }
+    }
+
+    MappedFile records_;
+    MappedFile names_;
+    size_t size_ = 0;
+  };
+}
@@ -0,0 +1,147 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Sharding.h - deterministic partition of tests in shards //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Splits registered tests among shardCount processes or machines
+   so that every test runs in exactly one shard:
+   - without durations, a test belongs to shard
+     stableHash(name) % shardCount, independent of registration
+     order, platform, and the other tests in the suite
+   - with durations recorded by an earlier run, tests are dealt
+     longest first to the least loaded shard, so shards finish at
+     about the same time; tests without a recorded duration are
+     weighted with the mean of the recorded ones
+   Every shard computes the same plan from the same names and
+   durations file, so no coordination between shards is needed.
+
+   Durations file format, one test per line:
+     <microseconds> <test name>
+
+   Package Dependencies:
+  -----------------------
+   Sharding.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+
+namespace Test {
+
+  /*-- FNV-1a, identical on every platform and build --*/
+  inline uint64_t stableHash(const std::string& name) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char ch : name) {
+      h ^= ch;
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  using Durations = std::unordered_map<std::string, double>;
+
+  /*-- read durations file, returns false if file can't be opened --*/
+  inline bool loadDurations(const std::string& path, Durations& durations) {
+    std::ifstream in(path);
+    if (!in.good())
+      return false;
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream ln(line);
+      double us = 0.0;
+      std::string name;
+      if (!(ln >> us))
+        continue;
+      ln >> std::ws;
+      std::getline(ln, name);
+      if (!name.empty())
+        durations[name] = us;
+    }
+    return true;
+  }
+
+  ///////////////////////////////////////////////
+  // ShardPlan class
+
+  class ShardPlan {
+  public:
+    using Selector = std::function<bool(const std::string&)>;
+
+    ShardPlan(size_t index = 0, size_t count = 1)
+      : index_(index), count_(count == 0 ? 1 : count) {}
+
+    void durations(const Durations& d) {
+      durations_ = d;
+    }
+    /*-- true if this shard runs the test, hash partition --*/
+    bool includes(const std::string& name) const {
+      return stableHash(name) % count_ == index_;
+    }
+    /*---------------------------------------------------
+      return predicate selecting this shard's tests
+      - names are all tests registered in the suite,
+        needed only for duration weighted plans
+    */
+    Selector selector(const std::vector<std::string>& names) const {
+      if (count_ == 1)
+        return [](const std::string&) { return true; };
+      if (durations_.empty()) {
+        size_t index = index_, count = count_;
+        return [index, count](const std::string& name) {
+          return stableHash(name) % count == index;
+        };
+      }
+      auto mine = std::make_shared<std::unordered_set<std::string>>(balance(names));
+      return [mine](const std::string& name) { return mine->count(name) > 0; };
+    }
+  private:
+    /*-- longest processing time first, deterministic tie breaks --*/
+    std::unordered_set<std::string> balance(const std::vector<std::string>& names) const {
+      double total = 0.0;
+      for (auto& d : durations_)
+        total += d.second;
+      double mean = total / durations_.size();
+
+      struct Item { double weight; uint64_t hash; const std::string* pName; };
+      std::vector<Item> items;
+      for (auto& name : names) {
+        auto iter = durations_.find(name);
+        double w = (iter == durations_.end()) ? mean : iter->second;
+        items.push_back(Item{ w, stableHash(name), &name });
+      }
+      std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        if (a.weight != b.weight) return a.weight > b.weight;
+        if (a.hash != b.hash) return a.hash < b.hash;
+        return *a.pName < *b.pName;
+      });
+      std::vector<double> load(count_, 0.0);
+      std::unordered_set<std::string> mine;
+      for (auto& item : items) {
+        size_t shard = std::min_element(load.begin(), load.end()) - load.begin();
+        load[shard] += item.weight;
+        if (shard == index_)
+          mine.insert(*item.pName);
+      }
+      return mine;
+    }
+    size_t index_;
+    size_t count_;
+    Durations durations_;
+  };
+}
@@ -0,0 +1,201 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Stress.h - run one test body on many threads at once    //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Stresses a bool() test body, e.g., one using a shared
+   BlockingQueue, to show races and how it scales:
+   - for each thread count n in opts.threadCounts, starts n
+     threads that wait at a barrier, then releases them all at
+     once, so they contend from the first call
+   - each thread calls the body opts.iterations times, counting
+     false returns, failed TEST_CHECKs, and exceptions, and
+     keeps going after a failure
+   - with opts.yields, or opts.maxSleep above zero, every call
+     is preceded by a stress point that may yield or sleep a
+     random time; bodies may call stressPoint() themselves, at
+     the places where a context switch is most likely to
+     expose a race
+   - under an Interleave.h explorer a stress point is a
+     scheduling point instead, where another thread may run
+   - reports calls, failures, and throughput for each thread
+     count, and speedup over the first
+
+   Package Dependencies:
+  -----------------------
+   Stress.h
+   TestClock.h
+   PropertyTest.h (Rng)
+   TestAssertions.h (failure slot)
+   Reporter.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.2 - 17 Oct 2026
+   - results may be shown through a Reporter
+   ver 1.1 - 17 Oct 2026
+   - stress points are scheduling points under an explorer
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <iostream>
+#include <sstream>
+#include <exception>
+#include "TestClock.h"
+#include "PropertyTest.h"
+#include "Reporter.h"
+#include "../TestUtilities/TestAssertions.h"
+
+namespace Test {
+
+  struct StressOptions {
+    std::vector<size_t> threadCounts{ 1, 2, 4, 8 };
+    size_t iterations = 1000;       // calls per thread
+    bool yields = false;            // yield at stress points, half the time
+    Nanoseconds maxSleep{ 0 };      // sleep up to this at stress points, 1 in 16
+    uint64_t seed = 1;
+  };
+
+  /*-- one thread count's run --*/
+  struct StressRun {
+    size_t threads = 0;
+    size_t calls = 0;
+    size_t failures = 0;
+    double seconds = 0.0;
+    double callsPerSecond = 0.0;
+    std::string message;            // first failure's check or exception text
+  };
+
+  struct StressResult {
+    std::string name;
+    bool passed = true;
+    std::vector<StressRun> runs;
+  };
+
+  namespace detail {
+    /*-- this thread's stress point settings, off outside stress runs --*/
+    struct StressPoints {
+      bool yields = false;
+      Nanoseconds maxSleep{ 0 };
+      Rng rng{ 0 };
+      void (*schedule)() = nullptr;   // set by an interleaving explorer
+    };
+    inline StressPoints& stressPoints() {
+      thread_local StressPoints points;
+      return points;
+    }
+  }
+
+  /*-- a place where a context switch might expose a race, no-op outside stress and explorer runs --*/
+  inline void stressPoint() {
+    detail::StressPoints& p = detail::stressPoints();
+    if (p.schedule) {
+      p.schedule();
+      return;
+    }
+    if (p.maxSleep.count() > 0 && p.rng.between(0, 15) == 0)
+      std::this_thread::sleep_for(Nanoseconds(p.rng.between<int64_t>(0, p.maxSleep.count())));
+    else if (p.yields && p.rng.between(0, 1) == 0)
+      std::this_thread::yield();
+  }
+
+  /*---------------------------------------------------
+    call body from n threads at once, for each n in
+    opts.threadCounts
+    - body must be safe to call concurrently, that is
+      what is being tested
+  */
+  template<typename F>
+  StressResult stress(F& body, const std::string& name, const StressOptions& opts = StressOptions()) {
+    StressResult result;
+    result.name = name;
+    for (size_t n : opts.threadCounts) {
+      if (n == 0)
+        continue;
+      StressRun run;
+      run.threads = n;
+      std::atomic<size_t> ready{ 0 };
+      std::atomic<bool> go{ false };
+      std::atomic<size_t> failures{ 0 };
+      std::mutex mtx;
+      std::vector<std::thread> threads;
+      threads.reserve(n);
+      for (size_t t = 0; t < n; ++t) {
+        threads.emplace_back([&, t]() {
+          detail::StressPoints& points = detail::stressPoints();
+          points.yields = opts.yields;
+          points.maxSleep = opts.maxSleep;
+          points.rng = Rng(Rng::caseSeed(opts.seed, n * 1000 + t));
+          ++ready;
+          while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+          size_t failed = 0;
+          for (size_t i = 0; i < opts.iterations; ++i) {
+            stressPoint();
+            FailureScope failure;
+            std::string why;
+            try {
+              if (body() && !failure.failed())
+                continue;
+              why = failure.failed() ? failure.message() : "test returned false";
+            }
+            catch (std::exception& ex) {
+              why = ex.what();
+            }
+            catch (...) {
+              why = "unknown exception";
+            }
+            if (failed++ == 0) {
+              std::lock_guard<std::mutex> l(mtx);
+              if (run.message.empty())
+                run.message = why;
+            }
+          }
+          failures += failed;
+          points = detail::StressPoints();
+        });
+      }
+      while (ready.load() < n)
+        std::this_thread::yield();
+      auto start = Clock::now();
+      go.store(true, std::memory_order_release);
+      for (auto& th : threads)
+        th.join();
+      run.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      run.calls = n * opts.iterations;
+      run.failures = failures.load();
+      run.callsPerSecond = run.seconds > 0.0 ? run.calls / run.seconds : 0.0;
+      result.passed &= run.failures == 0;
+      result.runs.push_back(std::move(run));
+    }
+    return result;
+  }
+
+  inline void showStress(const StressResult& r, std::ostream& out) {
+    out << "\n  " << r.name << (r.passed ? " passed" : " failed");
+    double base = r.runs.empty() ? 0.0 : r.runs.front().callsPerSecond;
+    for (auto& run : r.runs) {
+      out << "\n    " << run.threads << " threads: " << run.calls << " calls, " << run.failures
+        << " failed, " << static_cast<size_t>(run.callsPerSecond) << " calls/s";
+      if (base > 0.0)
+        out << ", speedup " << run.callsPerSecond / base;
+      if (!run.message.empty())
+        out << "\n      " << run.message;
+    }
+  }
+  /*-- report stress result as one note --*/
+  inline void showStress(const StressResult& r, Reporter& reporter = defaultReporter()) {
+    std::ostringstream out;
+    showStress(r, out);
+    noteLines(reporter, out.str());
+  }
+}
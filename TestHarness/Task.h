@@ -0,0 +1,223 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Task.h - lazily started coroutine returning a value     //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Provides the coroutine types used by asynchronous tests:
+   - Task<T>, a coroutine that starts when it is first awaited,
+     hands its result, or its exception, to the awaiting coroutine,
+     and resumes that coroutine directly when it finishes, so
+     chains of awaited Tasks don't grow the stack
+   - Detached, a fire-and-forget coroutine that destroys itself
+     when it finishes, used to start top level Tasks
+   - a Task keeps its failed TEST_CO_CHECKs in its own frame while
+     suspended: each co_await moves the thread's failure slot into
+     the promise and moves it back on resume, so a failure stays
+     with its test whichever thread resumes it, and a test resumed
+     later on the same thread doesn't see it
+
+   Example:
+     Task<int> answer() { co_return 42; }
+     Task<bool> test() { co_return co_await answer() == 42; }
+
+   Requires C++20 coroutines.  Compiled with an earlier standard,
+   this header declares nothing.
+
+   Package Dependencies:
+  -----------------------
+   Task.h
+   TestAssertions.h (failure slot)
+
+   Maintenance History:
+  ----------------------
+   ver 1.2 - 17 Oct 2026
+   - awaiting an empty, e.g., moved from, Task throws
+   ver 1.1 - 17 Oct 2026
+   - failure slot is saved in the promise across suspensions
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include "../TestUtilities/TestAssertions.h"
+
+namespace Test {
+
+  template<typename T = void>
+  class Task;
+
+  namespace detail {
+
+    /*-- awaiter of awaitable, its operator co_await() if it has one --*/
+    template<typename A>
+    decltype(auto) awaiterOf(A&& a) {
+      if constexpr (requires { std::forward<A>(a).operator co_await(); })
+        return std::forward<A>(a).operator co_await();
+      else
+        return std::forward<A>(a);
+    }
+
+    /*---------------------------------------------------
+      wraps an awaiter so the suspending coroutine's
+      failure slot is kept in saved while it's suspended
+      - saved is written before the inner await_suspend,
+        which may let another thread resume the coroutine
+    */
+    template<typename Awaiter>
+    struct FailureSavingAwaiter {
+      Awaiter awaiter;
+      Failure& saved;
+
+      bool await_ready() {
+        return awaiter.await_ready();
+      }
+      template<typename H>
+      auto await_suspend(H h) {
+        saved = std::move(failureSlot());
+        clearFailure();
+        try {
+          return awaiter.await_suspend(h);
+        }
+        catch (...) {
+          restore();
+          throw;
+        }
+      }
+      decltype(auto) await_resume() {
+        restore();
+        return awaiter.await_resume();
+      }
+      /*-- saved failure comes first, a finished child Task's failure is kept otherwise --*/
+      void restore() {
+        if (saved.count == 0)
+          return;
+        Failure& current = failureSlot();
+        saved.count += current.count;
+        current = std::move(saved);
+        saved = Failure();
+      }
+    };
+
+    /*-- parts of a Task promise that don't depend on the result type --*/
+    struct TaskPromiseBase {
+      struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template<typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+          std::coroutine_handle<> next = h.promise().continuation;
+          return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+      };
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      FinalAwaiter final_suspend() noexcept { return {}; }
+      void unhandled_exception() noexcept { error = std::current_exception(); }
+      template<typename A>
+      auto await_transform(A&& awaitable) {
+        using Awaiter = decltype(awaiterOf(std::forward<A>(awaitable)));
+        using Held = std::conditional_t<std::is_lvalue_reference_v<Awaiter>, Awaiter, std::remove_reference_t<Awaiter>>;
+        return FailureSavingAwaiter<Held>{ awaiterOf(std::forward<A>(awaitable)), failure };
+      }
+
+      std::coroutine_handle<> continuation;
+      std::exception_ptr error;
+      Failure failure;      // failure slot while suspended
+    };
+
+    template<typename T>
+    struct TaskPromise : TaskPromiseBase {
+      Task<T> get_return_object() noexcept;
+      template<typename V>
+      void return_value(V&& v) { value.emplace(std::forward<V>(v)); }
+      T result() {
+        if (error)
+          std::rethrow_exception(error);
+        return std::move(*value);
+      }
+      std::optional<T> value;
+    };
+
+    template<>
+    struct TaskPromise<void> : TaskPromiseBase {
+      Task<void> get_return_object() noexcept;
+      void return_void() noexcept {}
+      void result() {
+        if (error)
+          std::rethrow_exception(error);
+      }
+    };
+  }
+
+  ///////////////////////////////////////////////
+  // Task class
+
+  template<typename T>
+  class Task {
+  public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle h) noexcept : h_(h) {}
+    Task(Task&& other) noexcept : h_(std::exchange(other.h_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+      if (this != &other) {
+        if (h_)
+          h_.destroy();
+        h_ = std::exchange(other.h_, nullptr);
+      }
+      return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+      if (h_)
+        h_.destroy();
+    }
+    /*-- awaiting starts the task, resuming the awaiter when it's done, throws if empty --*/
+    bool await_ready() const noexcept {
+      return !h_ || h_.done();
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+      h_.promise().continuation = awaiter;
+      return h_;
+    }
+    T await_resume() {
+      if (!h_)
+        throw std::runtime_error("awaited an empty Task");
+      return h_.promise().result();
+    }
+  private:
+    Handle h_;
+  };
+
+  namespace detail {
+    template<typename T>
+    Task<T> TaskPromise<T>::get_return_object() noexcept {
+      return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+    }
+    inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+      return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+    }
+  }
+
+  /*-- starts immediately, frame is destroyed when the body finishes --*/
+  struct Detached {
+    struct promise_type {
+      Detached get_return_object() noexcept { return {}; }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+  };
+}
+#endif
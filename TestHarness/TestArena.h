@@ -0,0 +1,106 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestArena.h - contiguous storage for test class objects //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Provides TestArena, which constructs objects of any type in
+   large chunks of contiguous memory:
+   - objects are placed back to back, respecting alignment, so
+     iterating over many test classes walks memory sequentially
+   - one heap allocation per chunk instead of one per object
+   - objects never move, so pointers to them stay valid
+   - destructors run in reverse order of construction when
+     the arena is destroyed
+
+   Package Dependencies:
+  -----------------------
+   TestArena.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // TestArena class
+
+  class TestArena {
+  public:
+    explicit TestArena(size_t chunkSize = 64 * 1024) : chunkSize_(chunkSize) {}
+    TestArena(const TestArena&) = delete;
+    TestArena& operator=(const TestArena&) = delete;
+    TestArena(TestArena&&) = default;
+    TestArena& operator=(TestArena&& other) noexcept {
+      if (this != &other) {
+        clear();
+        chunks_ = std::move(other.chunks_);
+        dtors_ = std::move(other.dtors_);
+        chunkSize_ = other.chunkSize_;
+      }
+      return *this;
+    }
+    ~TestArena() {
+      clear();
+    }
+    /*-- construct U in arena, returning stable pointer --*/
+    template<typename U, typename... Args>
+    U* emplace(Args&&... args) {
+      static_assert(alignof(U) <= alignof(std::max_align_t), "over-aligned types not supported");
+      void* p = allocate(sizeof(U), alignof(U));
+      U* pU = ::new (p) U(std::forward<Args>(args)...);
+      if constexpr (!std::is_trivially_destructible_v<U>)
+        dtors_.push_back(Dtor{ pU, [](void* q) { static_cast<U*>(q)->~U(); } });
+      return pU;
+    }
+    /*-- destroy all objects and release chunks --*/
+    void clear() {
+      for (auto it = dtors_.rbegin(); it != dtors_.rend(); ++it)
+        it->destroy(it->p);
+      dtors_.clear();
+      chunks_.clear();
+    }
+  private:
+    struct Chunk {
+      std::unique_ptr<unsigned char[]> data;
+      size_t size = 0;
+      size_t used = 0;
+    };
+    struct Dtor {
+      void* p;
+      void (*destroy)(void*);
+    };
+    void* allocate(size_t size, size_t align) {
+      if (!chunks_.empty()) {
+        Chunk& c = chunks_.back();
+        size_t offset = (c.used + align - 1) / align * align;
+        if (offset + size <= c.size) {
+          c.used = offset + size;
+          return c.data.get() + offset;
+        }
+      }
+      Chunk c;
+      c.size = std::max(chunkSize_, size);
+      c.data.reset(new unsigned char[c.size]);
+      c.used = size;
+      chunks_.push_back(std::move(c));
+      return chunks_.back().data.get();
+    }
+    std::vector<Chunk> chunks_;
+    std::vector<Dtor> dtors_;
+    size_t chunkSize_;
+  };
+}
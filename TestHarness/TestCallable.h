@@ -0,0 +1,135 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestCallable.h - move-only, small buffer test callable  //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Provides TestCallable, the type-erased bool() callable used to
+   hold registered tests:
+   - accepts function pointers, lambdas with captures, and other
+     function objects, including move-only ones
+   - callables up to inlineSize bytes that are nothrow movable are
+     stored in an internal buffer, with no heap allocation
+   - larger callables are stored on the heap
+   - a call is one indirect call through a stored function
+     pointer, no virtual dispatch and no copy of the target
+   - move-only, so storing or running tests never copies captures
+
+   Package Dependencies:
+  -----------------------
+   TestCallable.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // TestCallable class
+
+  class TestCallable {
+  public:
+    static constexpr size_t inlineSize = 6 * sizeof(void*);
+
+    TestCallable() noexcept = default;
+    TestCallable(std::nullptr_t) noexcept {}
+
+    template<
+      typename F,
+      typename D = std::decay_t<F>,
+      typename = std::enable_if_t<
+        !std::is_same_v<D, TestCallable> && std::is_invocable_r_v<bool, D&>
+      >
+    >
+    TestCallable(F&& f) {
+      if constexpr (std::is_pointer_v<std::remove_reference_t<F>>) {
+        if (f == nullptr)
+          return;
+      }
+      if constexpr (fitsInline<D>()) {
+        ::new (static_cast<void*>(buffer_)) D(std::forward<F>(f));
+        invoke_ = [](void* p) -> bool { return (*static_cast<D*>(p))(); };
+        manage_ = [](Op op, void* src, void* dst) {
+          D* pSrc = static_cast<D*>(src);
+          if (op == Op::move)
+            ::new (dst) D(std::move(*pSrc));
+          pSrc->~D();
+        };
+      }
+      else {
+        *reinterpret_cast<D**>(buffer_) = new D(std::forward<F>(f));
+        invoke_ = [](void* p) -> bool { return (**static_cast<D**>(p))(); };
+        manage_ = [](Op op, void* src, void* dst) {
+          D** ppSrc = static_cast<D**>(src);
+          if (op == Op::move)
+            *static_cast<D**>(dst) = *ppSrc;
+          else
+            delete *ppSrc;
+        };
+      }
+    }
+    TestCallable(TestCallable&& other) noexcept {
+      moveFrom(other);
+    }
+    TestCallable& operator=(TestCallable&& other) noexcept {
+      if (this != &other) {
+        reset();
+        moveFrom(other);
+      }
+      return *this;
+    }
+    TestCallable(const TestCallable&) = delete;
+    TestCallable& operator=(const TestCallable&) = delete;
+
+    ~TestCallable() {
+      reset();
+    }
+    /*-- run target, empty callables must not be called --*/
+    bool operator()() {
+      return invoke_(buffer_);
+    }
+    explicit operator bool() const noexcept {
+      return invoke_ != nullptr;
+    }
+    /*-- destroy target, leaving callable empty --*/
+    void reset() noexcept {
+      if (manage_)
+        manage_(Op::destroy, buffer_, nullptr);
+      invoke_ = nullptr;
+      manage_ = nullptr;
+    }
+  private:
+    enum class Op { move, destroy };
+    using Invoke = bool(*)(void*);
+    using Manage = void(*)(Op, void*, void*);
+
+    template<typename D>
+    static constexpr bool fitsInline() {
+      return sizeof(D) <= inlineSize
+        && alignof(D) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<D>;
+    }
+    void moveFrom(TestCallable& other) noexcept {
+      if (other.manage_)
+        other.manage_(Op::move, other.buffer_, buffer_);
+      invoke_ = other.invoke_;
+      manage_ = other.manage_;
+      other.invoke_ = nullptr;
+      other.manage_ = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char buffer_[inlineSize];
+    Invoke invoke_ = nullptr;
+    Manage manage_ = nullptr;
+  };
+}
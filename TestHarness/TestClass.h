@@ -17,9 +17,14 @@
    ITest.h
    Tested.h, Tested.cpp
    Testharness.h, TestHarness.cpp
+   TestGraph.h
 
    Maintenance History:
   ----------------------
+   ver 1.2 : 17 Oct 2026
+   - banner goes to the executor's Reporter
+   ver 1.1 : 17 Oct 2026
+   - banner goes to the default Reporter
    ver 1.0 : 25 Jan 2020
    - first release
 */
@@ -27,6 +32,7 @@
 #include "ITest.h"
 #include "Tested.h"
 #include "TestHarness.h"
+#include "TestGraph.h"
 
 namespace Test {
   /*-- test class must implement ITest --*/
@@ -72,19 +78,22 @@ namespace Test {
     Test Environment:
     - All code built with C++17 option
     Test Operation:
-    - run each of the implementing tests: test1 to test4
+    - run the implementing tests, test1 to test4, as a TestGraph
+    - test1 reads the initial name that test2 changes, and test3
+      reads the name test2 sets, so they run in that order, while
+      test4 is independent and may run concurrently
   */
   bool TestWidgetClass::test() {
-    std::cout << "\n  Testing " << name();
-    bool t1 = executor_.doTest(&TestWidgetClass::test1, this);
-    executor_.showResult(t1, "test1");
-    bool t2 = executor_.doTest(&TestWidgetClass::test2, this);
-    executor_.showResult(t2, "test2");
-    bool t3 = executor_.doTest(&TestWidgetClass::test3, this);
-    executor_.showResult(t3, "test3");
-    bool t4 = executor_.doTest(&TestWidgetClass::test4, this);
-    executor_.showResult(t4, "test4");
-    return t1 && t2 && t3 && t4;
+    executor_.reporter().note("Testing " + name());
+    TestGraph graph;
+    graph.add("test1", [this]() { return test1(); });
+    graph.add("test2", [this]() { return test2(); }, { "test1" });
+    graph.add("test3", [this]() { return test3(); }, { "test2" });
+    graph.add("test4", [this]() { return test4(); });
+    bool result = graph.run();
+    for (auto& r : graph.results())
+      executor_.showResult(r);
+    return result;
   }
   /*-- Requirement #1 Widget Class --*/
   /*-- Widget is initialized with name = "unknown --*/
@@ -106,7 +115,7 @@ namespace Test {
      Requirement #3 Widget Class
      - Widget::say() returns
        "hi from Widget instance " + name_
-     - Requires test2() to run immediately before this test
+     - Depends on test2(), declared in test()
   */
   bool TestWidgetClass::test3() {
     std::string temp = pWidget_->say();
@@ -0,0 +1,65 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestClock.h - wall and cpu time sources for tests       //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Provides time sources used to measure test execution:
+   - Clock, a monotonic clock for wall time
+   - threadCpuTime(), cpu time consumed by the calling thread
+   - microseconds(d), converts a duration to double microseconds
+
+   Package Dependencies:
+  -----------------------
+   TestClock.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <chrono>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <time.h>
+#endif
+
+namespace Test {
+
+  /*-- monotonic clock, never adjusted by system time changes --*/
+  using Clock = std::chrono::steady_clock;
+  using Nanoseconds = std::chrono::nanoseconds;
+
+  /*-- cpu time used by calling thread, user + kernel --*/
+  inline Nanoseconds threadCpuTime() {
+#ifdef _WIN32
+    FILETIME create, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &create, &exit, &kernel, &user))
+      return Nanoseconds(0);
+    auto ticks = [](const FILETIME& ft) {
+      return (static_cast<long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    /* FILETIME counts 100 nanosecond intervals */
+    return Nanoseconds((ticks(kernel) + ticks(user)) * 100);
+#else
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+      return Nanoseconds(0);
+    return Nanoseconds(static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec);
+#endif
+  }
+
+  /*-- convert any duration to microseconds --*/
+  template<typename Rep, typename Period>
+  inline double microseconds(std::chrono::duration<Rep, Period> d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+  }
+}
@@ -7,7 +7,25 @@
 #include "TestClass.h"
 #include "Tested.h"
 #include "Testharness.h"
+#include "TestOptions.h"
+#include "Sharding.h"
+#include "TestRegistry.h"
+#include "FixtureCache.h"
+#include "PropertyTest.h"
+#include "Fuzzer.h"
+#include "ResultStore.h"
+#include "AsyncTest.h"
+#include "Interleave.h"
+#include "../Cpp11-BlockingQueue/Cpp11-BlockingQueue.h"
+#include "../DateTime/DateTime.h"
 #include "../TestUtilities/TestUtilities.h"
+#include <fstream>
+#include <filesystem>
+#include <numeric>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <sstream>
 
 using namespace testedCode;
 using namespace Test;
@@ -21,10 +39,358 @@ bool testTester() {
 bool alwaysFails() {
   return false;
 }
+/*-- fails with a recorded check, no exception thrown --*/
+bool checksGreeting() {
+  std::unique_ptr<IWidget> pWidget = createWidget("Ann");
+  TEST_REQUIRES(pWidget != nullptr);
+  TEST_CHECK_MSG(pWidget->say().find("Bob") != std::string::npos, "greeting was \"" + pWidget->say() + "\"");
+  return true;
+}
+bool neverReturns() {
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::unique_lock<std::mutex> l(mtx);
+  cv.wait(l, []() { return false; });
+  return true;
+}
+bool noAllocations() {
+  AllocScope scope;
+  int squares[10];
+  for (int i = 0; i < 10; ++i)
+    squares[i] = i * i;
+  return scope.atMost(0) && squares[9] == 81;
+}
+bool allocates() {
+  std::vector<int> v(100, 1);
+  return v.size() == 100;
+}
+bool sumVector() {
+  static std::vector<int> v(1000, 1);
+  int sum = 0;
+  for (int i : v)
+    sum += i;
+  return sum == 1000;
+}
+/*-- touches 32 MB, releasing it before returning --*/
+bool touchesPages() {
+  std::vector<char> buffer(32 << 20, 1);
+  return buffer.back() == 1;
+}
+/*-- keeps 8 MB more each time it runs --*/
+bool keepsPages() {
+  static std::vector<std::vector<char>> kept;
+  kept.emplace_back(8 << 20, 1);
+  return kept.back().front() == 1;
+}
+
+/*-- fuzz target, DateTime may reject bad strings by throwing std::exception --*/
+bool fuzzDateTime(const uint8_t* data, size_t size) {
+  try {
+    Utilities::DateTime dt(std::string(reinterpret_cast<const char*>(data), size));
+  }
+  catch (std::exception&) {
+  }
+  return true;
+}
+
+/*-- second test class, to show heterogeneous registration --*/
+class TestGreeting : public ITest {
+public:
+  TestGreeting(const std::string& who) : who_(who) {}
+  bool test() override {
+    return createWidget(who_)->say() == "hi from Widget instance " + who_;
+  }
+  std::string name() override {
+    return "TestGreeting(" + who_ + ")";
+  }
+private:
+  std::string who_;
+};
+
+#ifdef __cpp_impl_coroutine
+/*-- coroutine test class, waits without holding a thread --*/
+class TestPingPong : public IAsyncTest {
+public:
+  Task<bool> test() override {
+    AsyncQueue<int> ping, pong;
+    auto echo = [&]() -> Task<void> {
+      for (int i = 0; i < 3; ++i)
+        pong.push(co_await ping.pop() + 1);
+    };
+    Task<void> echoing = echo();
+    ping.push(1);
+    ping.push(2);
+    ping.push(3);
+    co_await echoing;
+    int sum = co_await pong.pop() + co_await pong.pop() + co_await pong.pop();
+    co_return sum == 9;
+  }
+  std::string name() override {
+    return "TestPingPong";
+  }
+};
+#endif
+
+TEST_FUNCTION(registeredPasses, "fast") {
+  return true;
+}
+TEST_FUNCTION(registeredFails, "fast") {
+  return false;
+}
+/*-- regex filters with {n,m} quantifiers select the names std::regex matches --*/
+TEST_FUNCTION(regexFilterBraceQuantifiers, "fast filter") {
+  TestIndex index;
+  index.add("case 124");
+  index.add("aaaa");
+  index.add("case 12");
+  index.add("ab");
+  auto selects = [&](const std::string& expression, std::vector<bool> expected) {
+    Selection s = TestFilter(expression).match(index);
+    for (size_t id = 0; id < expected.size(); ++id)
+      TEST_CHECK_MSG(s[id] == expected[id], expression + " on " + index.name(id));
+    return true;
+  };
+  selects("/[0-9]{3}/", { true, false, false, false });
+  selects("/a{4}/", { false, true, false, false });
+  selects("/^a{2}/", { false, true, false, false });
+  selects("/^a{1,2}b/", { false, false, false, true });
+  selects("/case 1{1}2{1}/", { true, false, true, false });
+  return true;
+}
+
+TEST_FUNCTION(benchmarkKeepsCheckFailures, "fast benchmark") {
+  BenchmarkOptions brief;
+  brief.warmupIterations = 0;
+  BenchmarkResult r = benchmark([]() { TEST_CHECK_MSG(1 + 1 == 3, "bad sum"); return true; }, "failing check", brief);
+  TEST_CHECK(!r.passed);
+  TEST_CHECK(r.message.find("bad sum") != std::string::npos);
+  return true;   // the benchmark's failure must not land in this test's slot
+}
+
+/*-- fuzz() puts back the crash handlers it found --*/
+void onTestSignal(int) {}
+
+TEST_FUNCTION(fuzzRestoresSignalHandlers, "fast fuzz") {
+  auto previous = std::signal(SIGFPE, onTestSignal);
+  FuzzOptions brief;
+  brief.maxRuns = 10;
+  fuzz([](const uint8_t*, size_t) { return true; }, brief);
+  auto after = std::signal(SIGFPE, previous);
+  TEST_CHECK(after == onTestSignal);
+  return true;
+}
+
+/*-- registered by qualified name --*/
+namespace Registered {
+  class TestDefaultGreeting : public ITest {
+  public:
+    bool test() override {
+      return createWidget("Dee")->say() == "hi from Widget instance Dee";
+    }
+    std::string name() override {
+      return "Registered::TestDefaultGreeting";
+    }
+  };
+}
+TEST_CLASS(Registered::TestDefaultGreeting, "fast")
+
+/*-- tasks submitted from outside a pool start in submission order, give or take one per worker --*/
+TEST_FUNCTION(poolStartsInSubmissionOrder, "fast pool") {
+  for (size_t threads : { 1, 2, 4 }) {
+    std::mutex mtx;
+    std::vector<size_t> started;
+    {
+      ThreadPool pool(threads);
+      for (size_t i = 0; i < 64; ++i) {
+        pool.submit([&, i]() {
+          {
+            std::lock_guard<std::mutex> l(mtx);
+            started.push_back(i);
+          }
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+        });
+      }
+      pool.wait();
+    }
+    TEST_CHECK(started.size() == 64);
+    for (size_t pos = 0; pos < started.size(); ++pos) {
+      size_t i = started[pos];
+      TEST_CHECK_MSG((i > pos ? i - pos : pos - i) < threads,
+        std::to_string(threads) + " threads, task " + std::to_string(i) + " started at " + std::to_string(pos));
+    }
+  }
+  return true;
+}
+
+/*-- a graph run inside a pool task, e.g., a test of a parallel run, runs on that worker --*/
+TEST_FUNCTION(graphRunsInlineOnWorker, "fast pool") {
+  std::thread::id worker;
+  std::vector<std::thread::id> ran(3);
+  bool passed = false;
+  {
+    ThreadPool pool(2);
+    pool.submit([&]() {
+      worker = std::this_thread::get_id();
+      std::ostringstream discarded;
+      ExecutorOptions quiet;
+      quiet.reporter = std::make_shared<ConsoleReporter>(discarded);
+      TestGraph graph(quiet);
+      graph.add("a", [&]() { ran[0] = std::this_thread::get_id(); return true; });
+      graph.add("b", [&]() { ran[1] = std::this_thread::get_id(); return true; }, { "a" });
+      graph.add("c", [&]() { ran[2] = std::this_thread::get_id(); return true; });
+      passed = graph.run(4);
+    });
+    pool.wait();
+  }
+  TEST_CHECK(passed);
+  for (auto& id : ran)
+    TEST_CHECK(id == worker);
+  return true;
+}
+
+/*-- doTestsParallel starts tests in plan order, e.g., longest first from history --*/
+TEST_FUNCTION(parallelRunStartsInPlanOrder, "fast pool") {
+  std::ostringstream discarded;
+  TestSequencer<ITest> seq;
+  ExecutorOptions quiet;
+  quiet.reporter = std::make_shared<ConsoleReporter>(discarded);
+  seq.options(quiet);
+  for (int i = 0; i < 8; ++i) {
+    seq.reg([i]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(8 - i));
+      return true;
+    }, "t" + std::to_string(i));
+  }
+  seq.doTestsParallel(2);
+  const TestResults& results = seq.results();
+  TEST_CHECK(results.size() == 8);
+  for (size_t i = 2; i < results.size(); ++i)
+    TEST_CHECK_MSG(results[i - 2].start <= results[i].start, results[i].name + " started too early");
+  return true;
+}
+
+/*-- history runs a recent failure first serially, and the longest test first in parallel --*/
+TEST_FUNCTION(historyOrdersRuns, "fast pool") {
+  std::string path = (std::filesystem::temp_directory_path() / "TestExecutiveOrder.history").string();
+  auto writeHistory = [&path]() {
+    std::ofstream out(path);
+    out << "4 1 0 100 failedLast\n"
+      << "4 0 -1 20000 long\n"
+      << "4 0 -1 500 steady\n";
+  };
+  std::ostringstream discarded;
+  TestSequencer<ITest> seq;
+  ExecutorOptions quiet;
+  quiet.reporter = std::make_shared<ConsoleReporter>(discarded);
+  seq.options(quiet);
+  seq.history(path);
+  seq.reg([]() { return true; }, "steady");
+  seq.reg([]() { return true; }, "long");
+  seq.reg([]() { return true; }, "failedLast");
+
+  writeHistory();
+  seq.doTests();
+  TEST_CHECK(seq.results().size() == 3);
+  TEST_CHECK(seq.results().front().name == "failedLast");
+
+  writeHistory();
+  seq.doTestsParallel(2);
+  const TestResults& results = seq.results();
+  TEST_CHECK(results.size() == 3);
+  TEST_CHECK(results.front().name == "long");
+  TEST_CHECK(results.front().start <= results.back().start);
+  std::filesystem::remove(path);
+  return true;
+}
+
+/*-- the main sequencer's tests, registered without constructing test classes --*/
+void registerSuite(TestSequencer<TestWidgetClass>& te) {
+  te.regLazy<TestWidgetClass>("TestWidgetClass", "widget", TEST_HERE);
+  te.reg(testTester, "testTester", "fast", TEST_HERE);
+  te.reg(alwaysFails, "alwaysFails", "fast", TEST_HERE);
+  std::string expected = "hi from Widget instance captured";
+  te.reg([expected]() {
+    return createWidget("captured")->say() == expected;
+  }, "capturingLambda", "widget", TEST_HERE);
+}
+
+/*-- one line of a test list: name [tags] file:line --*/
+void showTestInfo(std::string_view name, std::string_view tags, const char* file, int line) {
+  std::cout << "\n  " << name << " [" << tags << "]";
+  if (file && *file)
+    std::cout << " " << file << ":" << line;
+}
 
 Cosmetic c;
 
-int main() {
+int main(int argc, char* argv[]) {
+
+  TestOptions opts;
+  TestFilter filter;
+  try {
+    opts = parseOptions(argc, argv);
+    filter = TestFilter::anyOf(opts.filters);
+  }
+  catch (std::exception& ex) {
+    std::cout << "\n  " << ex.what() << "\n";
+    return 1;
+  }
+
+  std::ofstream reportFile;
+  if (!opts.reportFile.empty()) {
+    reportFile.open(opts.reportFile);
+    if (!reportFile.good()) {
+      std::cout << "\n  can't open " << opts.reportFile << "\n";
+      return 1;
+    }
+  }
+  try {
+    useReporter(makeReporter(opts.reporter, reportFile.is_open() ? reportFile : std::cout));
+  }
+  catch (std::exception& ex) {
+    std::cout << "\n  " << ex.what() << "\n";
+    return 1;
+  }
+
+  if (opts.list) {
+    TestSequencer<TestWidgetClass> te;
+    registerSuite(te);
+    std::vector<TestInfo> infos = te.list();
+    Selection selected = filter.match(te.index());
+    size_t count = 0;
+    for (size_t i = 0; i < infos.size(); ++i) {
+      if (selected[i]) {
+        showTestInfo(infos[i].name, infos[i].tags, infos[i].location.file, infos[i].location.line);
+        ++count;
+      }
+    }
+    Selection registered = filter.match(registryIndex());
+    size_t id = 0;
+    for (const TestEntry& entry : testRegistry) {
+      if (registered[id++]) {
+        showTestInfo(entry.name, entry.tags, entry.file, entry.line);
+        ++count;
+      }
+    }
+    std::cout << "\n  " << count << " tests\n";
+    return 0;
+  }
+
+  if (!opts.fuzz.empty()) {
+    if (opts.fuzz != "DateTime") {
+      std::cout << "\n  unknown fuzz target " << opts.fuzz << ", known targets: DateTime\n";
+      return 1;
+    }
+    Title("Fuzzing " + opts.fuzz);
+    FuzzOptions fuzzing;
+    fuzzing.corpusDir = opts.corpus;
+    fuzzing.maxRuns = opts.fuzzRuns;
+    fuzzing.seeds = { "Sat Oct 17 10:00:00 2026" };
+    FuzzResult fr = fuzz(fuzzDateTime, fuzzing);
+    showFuzz(fr);
+    putline(2);
+    return fr.passed ? 0 : 1;
+  }
 
   Title("Testing TestClass");
 
@@ -47,16 +413,407 @@ int main() {
   executor.showResult(ta, "testTester");
   bool tb = executor.doTest(alwaysFails);
   executor.showResult(tb, "alwaysFails");
+  executor.showResult(executor.doTest(checksGreeting, "checksGreeting"));
   putline(1);
 
   title("Testing TestSequencer");
 
-  TestWidgetClass tc2;
   TestSequencer<TestWidgetClass> te;
-  te.reg(tc2);
-  te.reg(testTester, "testTester");
-  te.reg(alwaysFails, "alwaysFails");
+  registerSuite(te);
+
+  ShardPlan plan(opts.shardIndex, opts.shardCount);
+  if (!opts.shardDurations.empty()) {
+    Durations durations;
+    if (loadDurations(opts.shardDurations, durations))
+      plan.durations(durations);
+    else
+      std::cout << "\n  can't open " << opts.shardDurations << ", using hash partition";
+  }
+  std::vector<std::string> shardNames = te.names();
+  for (auto& name : registryNames())
+    shardNames.push_back(std::move(name));
+  auto inShard = plan.selector(shardNames);   // one plan over sequencer and registry tests
+  auto inFilter = filter.selector(te.index());
+  te.select([=](const std::string& name) { return inShard(name) && inFilter(name); });
+  te.history(opts.history);
+  te.store(opts.store);
+  std::cout << "\n  shard " << opts.shardIndex << " of " << opts.shardCount;
   te.doTests();
+  if (!opts.stressThreads.empty()) {
+    StressOptions stressing;
+    stressing.threadCounts = opts.stressThreads;
+    stressing.iterations = opts.stressIterations;
+    stressing.yields = true;
+    te.doStress(stressing);
+  }
+  if (!opts.writeDurations.empty()) {
+    std::ofstream out(opts.writeDurations);
+    te.writeDurations(out);
+  }
+  putline(1);
+
+  title("Testing parallel TestSequencer");
+
+  TestWidgetClass tc3;
+  TestSequencer<TestWidgetClass> tp;
+  tp.reg(tc3);
+  tp.reg(testTester, "testTester");
+  tp.reg(alwaysFails, "alwaysFails");
+  bool tpr = tp.doTestsParallel();
+  std::cout << "\n  all tests passed: " << tpr;
+  putline(1);
+
+  title("Slowest tests of parallel run");
+  std::cout << "\n";
+  tp.writeResults(std::cout, tp.slowest(2));
+
+  title("Benchmarking registered functions");
+
+  TestSequencer<TestWidgetClass> bench;
+  bench.reg(sumVector, "sumVector");
+  bench.reg(alwaysFails, "alwaysFails");
+  RegressionOptions gating;
+  gating.update = opts.updateBaseline;
+  bench.baseline(opts.baseline, gating);
+  bench.doBenchmarks();
+  putline(1);
+
+  title("Gating benchmarks on a baseline");
+
+  std::string baselinePath = (std::filesystem::temp_directory_path() / "TestExecutiveDemo.baseline").string();
+  std::remove(baselinePath.c_str());
+  size_t work = 1000;
+  TestSequencer<TestWidgetClass> gated;
+  gated.reg([&work]() {
+    std::vector<int> v(work, 1);
+    return std::accumulate(v.begin(), v.end(), size_t(0)) == work;
+  }, "sumNewVector");
+  gated.baseline(baselinePath);
+  BenchmarkOptions measured;
+  measured.allocations = true;
+  gated.doBenchmarks(measured);
+  std::cout << "\n  recorded baseline, now four times the work";
+  work = 4000;
+  gated.doBenchmarks(measured);
+  for (auto& g : gated.regressions())
+    std::cout << "\n  " << g.name << " time change " << g.timeChange * 100.0 << "%, p = " << g.pValue;
+  putline(1);
+
+  title("Stressing shared code on many threads");
+
+  std::atomic<int> inside{ 0 };
+  std::mutex guard;
+  BlockingQueue<int> shared;
+  auto enterAndLeave = [&inside]() {
+    int others = inside.fetch_add(1);
+    stressPoint();
+    inside.fetch_sub(1);
+    TEST_CHECK_MSG(others == 0, std::to_string(others) + " other threads inside");
+    return true;
+  };
+  TestSequencer<TestWidgetClass> tstress;
+  tstress.reg(enterAndLeave, "unguardedSection");
+  tstress.reg([&guard, enterAndLeave]() mutable {
+    std::lock_guard<std::mutex> l(guard);
+    return enterAndLeave();
+  }, "guardedSection");
+  tstress.reg([&shared]() {
+    shared.enQ(1);
+    stressPoint();
+    return shared.deQ() == 1;
+  }, "blockingQueue");
+  StressOptions stressing;
+  stressing.threadCounts = { 1, 2, 4 };
+  stressing.iterations = 2000;
+  stressing.yields = true;
+  tstress.doStress(stressing);
+  putline(1);
+
+  title("Exploring thread interleavings");
+
+  using ScheduledQueue = BlockingQueue<int, ScheduledMutex, ScheduledConditionVariable>;
+  InterleaveOptions exhaustive;
+  exhaustive.systematic = true;
+  TestSequencer<TestWidgetClass> tinter;
+  tinter.reg(interleavings([](Interleaving& x) {
+    auto q = std::make_shared<ScheduledQueue>();
+    x.spawn([q]() { q->enQ(1); });
+    x.spawn([q]() { q->enQ(2); });
+    x.spawn([q]() {
+      int first = q->deQ();
+      TEST_CHECK(first + q->deQ() == 3);
+      return true;
+    });
+  }, exhaustive), "twoProducersOneConsumer");
+  tinter.doTests();
+
+  auto lostUpdate = [](Interleaving& x) {
+    auto count = std::make_shared<int>(0);
+    for (int i = 0; i < 2; ++i) {
+      x.spawn([count]() {
+        int seen = *count;
+        stressPoint();
+        *count = seen + 1;
+      });
+    }
+    x.atEnd([count]() { TEST_CHECK(*count == 2); return true; });
+  };
+  InterleaveResult ir = explore(lostUpdate, "lostUpdate", exhaustive);
+  showInterleave(ir);
+  InterleaveOptions replaying;
+  replaying.replay = ir.schedule;
+  std::cout << "\n  replaying schedule " << ir.schedule << ":";
+  showInterleave(explore(lostUpdate, "lostUpdate", replaying));
+
+  auto lockOrder = [](Interleaving& x) {
+    auto a = std::make_shared<ScheduledMutex>(), b = std::make_shared<ScheduledMutex>();
+    x.spawn([a, b]() { std::lock_guard<ScheduledMutex> la(*a); std::lock_guard<ScheduledMutex> lb(*b); });
+    x.spawn([a, b]() { std::lock_guard<ScheduledMutex> lb(*b); std::lock_guard<ScheduledMutex> la(*a); });
+  };
+  ir = explore(lockOrder, "lockOrder");
+  showInterleave(ir);
+  InterleaveOptions reseeded;
+  reseeded.seed = ir.seed;
+  reseeded.schedules = 1;
+  std::cout << "\n  replaying seed " << ir.seed << ":";
+  showInterleave(explore(lockOrder, "lockOrder", reseeded));
+  putline(1);
+
+  title("Collecting event counters");
+
+  ExecutorOptions counting;
+  counting.counters = true;
+  TestSequencer<TestWidgetClass> tcount;
+  tcount.options(counting);
+  tcount.reg(sumVector, "sumVector");
+  tcount.reg(testTester, "testTester");
+  tcount.doTests();
+  putline(1);
+
+  title("Counting allocations");
+
+  ExecutorOptions allocOpts;
+  allocOpts.allocations = true;
+  allocOpts.maxAllocations = 0;
+  TestSequencer<TestWidgetClass> talloc;
+  talloc.options(allocOpts);
+  talloc.reg(noAllocations, "noAllocations");
+  talloc.reg(allocates, "allocates");
+  talloc.doTests();
+  putline(1);
+
+  title("Measuring memory footprint");
+
+  ExecutorOptions footprint;
+  footprint.resources = true;
+  footprint.maxPeakRss = 16 << 20;
+  TestSequencer<TestWidgetClass> tfoot;
+  tfoot.options(footprint);
+  tfoot.reg(sumVector, "sumVector");
+  tfoot.reg(touchesPages, "touchesPages");
+  tfoot.reg(keepsPages, "keepsPages");
+  tfoot.doTests();
+  putline(1);
+
+  title("Testing heterogeneous TestSequencer<ITest>");
+
+  TestWidgetClass tc4;
+  TestSequencer<ITest> suite;
+  suite.reg(tc4);
+  suite.emplace<TestGreeting>("Ann");
+  suite.emplace<TestGreeting>("Bob");
+  suite.reg(testTester, "testTester");
+  suite.doTestsParallel();
+  putline(1);
+
+  title("Enforcing test timeouts");
+
+  ExecutorOptions timed;
+  timed.testTimeout = std::chrono::milliseconds(100);
+  TestSequencer<TestWidgetClass> ttimed;
+  ttimed.options(timed);
+  ttimed.reg(testTester, "testTester");
+  ttimed.reg(neverReturns, "neverReturns");
+  ttimed.reg(alwaysFails, "alwaysFails");
+  ttimed.timeout("alwaysFails", std::chrono::seconds(1));
+  ttimed.doTests();
+  for (auto& r : ttimed.failures())
+    std::cout << "\n  " << r.name << " : " << r.message;
+  putline(1);
+
+  title("Sharing a lazily built fixture");
+
+  using Dataset = std::vector<int>;
+  declareFixture<Dataset>("dataset", []() {
+    std::cout << "\n  building dataset";
+    return Dataset(100000, 1);
+  });
+  TestSequencer<TestWidgetClass> tfix;
+  tfix.reg(usingFixtures({ "dataset" }, []() {
+    return fixture<Dataset>("dataset")->size() == 100000;
+  }), "datasetSize");
+  tfix.reg(usingFixtures({ "dataset" }, []() {
+    FixtureRef<Dataset> data = fixture<Dataset>("dataset");
+    data.mutate().push_back(2);
+    return data->size() == 100001 && fixture<Dataset>("dataset")->size() == 100000;
+  }), "datasetPrivateCopy");
+  tfix.doTests();
+  std::cout << "\n  dataset built after last user: " << FixtureCache::instance().isBuilt("dataset");
+  BenchmarkOptions brief;
+  brief.warmupIterations = 1;
+  brief.samples = 5;
+  brief.minSampleTime = std::chrono::microseconds(200);
+  tfix.doBenchmarks(brief);   // dataset is built once for both benchmarks, not per iteration
+  std::cout << "\n  dataset built after benchmarks: " << FixtureCache::instance().isBuilt("dataset");
+  putline(1);
+
+  title("Property based and parameterised tests");
+
+  TestSequencer<TestWidgetClass> tprop;
+  PropertyOptions many;
+  many.cases = 100000;
+  tprop.reg(forAll(vectorsOf(integers(-100, 100), 50), [](const std::vector<int>& v) {
+    std::vector<int> r(v.rbegin(), v.rend());
+    std::reverse(r.begin(), r.end());
+    return r == v;
+  }, many), "reverseTwice");
+  tprop.reg(forAll(vectorsOf(integers(0, 1000), 20), [](const std::vector<int>& v) {
+    return std::all_of(v.begin(), v.end(), [](int x) { return x < 900; });
+  }), "allBelow900");
+  tprop.reg(forEach(std::vector<std::string>{ "Ann", "Bob", "" }, [](const std::string& who) {
+    return !createWidget(who)->say().empty() && !who.empty();
+  }), "greetsEveryone");
+  tprop.doTests();
+  putline(1);
+
+  title("Failing often, checks versus exceptions");
+
+  auto evenByCheck = [](int x) {
+    TEST_CHECK(x % 2 == 0);
+    return true;
+  };
+  auto evenByThrow = [](int x) {
+    if (x % 2 != 0)
+      throw std::runtime_error("odd");
+    return true;
+  };
+  auto timeFailures = [](auto property) {
+    auto start = Clock::now();
+    size_t failures = 0;
+    for (int i = 0; i < 100000; ++i) {
+      FailureScope failure;
+      try {
+        if (!property(i))
+          ++failures;
+      }
+      catch (std::exception&) {
+        ++failures;
+      }
+    }
+    std::cout << failures << " failures in " << microseconds(Clock::now() - start) / 1000 << " ms";
+    return failures;
+  };
+  std::cout << "\n  TEST_CHECK: ";
+  timeFailures(evenByCheck);
+  std::cout << "\n  throw:      ";
+  timeFailures(evenByThrow);
+  putline(1);
+
+  title("Storing results of a large suite");
+
+  namespace fs = std::filesystem;
+  std::string storePath = (fs::temp_directory_path() / "TestExecutiveDemo.store").string();
+  fs::remove(storePath);
+  fs::remove(storePath + ".names");
+  std::ostringstream unseen;
+  ExecutorOptions quiet;
+  quiet.reporter = std::make_shared<ConsoleReporter>(unseen);
+  TestSequencer<TestWidgetClass> tstore;
+  tstore.options(quiet);
+  tstore.store(storePath);
+  int failEvery = 97;
+  for (int i = 0; i < 20000; ++i)
+    tstore.reg([i, &failEvery]() { return i % failEvery != 0; }, "case " + std::to_string(i));
+  tstore.doTestsParallel();
+  failEvery = 89;
+  tstore.doTestsParallel();
+  ResultStore stored;
+  if (stored.open(storePath)) {
+    ResultStore::Range last = stored.run(stored.lastRun());
+    std::cout << "\n  " << stored.size() << " records, run " << stored.lastRun() << " has "
+      << stored.failures(last).size() << " failures";
+    for (const StoredResult* p : stored.slowest(last, 3))
+      std::cout << "\n  slow: " << stored.name(*p) << ", " << p->durationNs << " ns";
+    auto changes = stored.diff(last, stored, stored.run(stored.lastRun() - 1));
+    std::cout << "\n  " << changes.size() << " tests changed since run " << stored.lastRun() - 1;
+  }
+  putline(1);
+
+  title("Fuzzing the DateTime parser");
+
+  FuzzOptions quick;
+  quick.maxRuns = 20000;
+  quick.crashDir = "";
+  quick.seeds = { "Sat Oct 17 10:00:00 2026" };
+  showFuzz(fuzz(fuzzDateTime, quick));
+  putline(1);
+
+#ifdef __cpp_impl_coroutine
+  title("Running coroutine tests on an EventLoop");
+
+  AsyncSequencer async;
+  async.emplace<TestPingPong>();
+  for (int i = 0; i < 1000; ++i) {
+    async.reg([]() -> Task<bool> {
+      co_await sleepFor(std::chrono::milliseconds(20));
+      co_return true;
+    }, "sleeper" + std::to_string(i));
+  }
+  async.reg([]() -> Task<bool> {
+    BlockingQueue<std::string> q;
+    std::thread producer([&q]() { q.enQ("message"); });
+    std::string msg = co_await blocking([&q]() { return q.deQ(); });
+    producer.join();
+    co_return msg == "message";
+  }, "blockingDeQ");
+  async.reg([]() -> Task<bool> {
+    auto check = []() -> Task<bool> {
+      TEST_CO_CHECK(std::string("Ann").size() == 4);
+      co_return true;
+    };
+    co_await check();
+    co_await sleepFor(std::chrono::milliseconds(5));   // failure must follow this test, not the sleepers
+    co_return true;
+  }, "checkFailsThenSleeps");
+  auto asyncStart = Clock::now();
+  bool asyncOk = true;
+  {
+    std::ostringstream discarded;
+    ExecutorOptions quiet;
+    quiet.reporter = std::make_shared<ConsoleReporter>(discarded);
+    async.options(quiet);
+    asyncOk = async.doTests(2);
+  }
+  std::cout << "\n  " << async.results().size() << " coroutine tests on 2 threads in "
+    << microseconds(Clock::now() - asyncStart) / 1000 << " ms, all passed: " << asyncOk;
+  Executor<ITest> asyncEx;
+  for (auto& r : async.results())
+    if (r.name.rfind("sleeper", 0) != 0)
+      asyncEx.showResult(r);
+  putline(1);
+#endif
+
+  title("Listing statically registered tests");
+  for (const TestEntry& entry : testRegistry)
+    showTestInfo(entry.name, entry.tags, entry.file, entry.line);
+  putline(1);
+
+  title("Running statically registered tests");
+  doRegisteredTests(ExecutorOptions(), filter, inShard);
+  putline(1);
+
+  /* finish, e.g., close a JUnit document, before reportFile closes */
+  useReporter(std::make_shared<ConsoleReporter>());
 }
 #endif
 
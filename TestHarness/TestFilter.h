@@ -0,0 +1,507 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestFilter.h - compiled test name and tag filters       //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Selects tests by name and tag with filter expressions:
+     perf && !slow              tags
+     Parse* || name:sumVector   name globs, * and ?
+     /^Date.*(Year|Month)/      name regex, searched anywhere
+     (fast || perf) && !*Widget*
+   A bare word is a tag, a word holding * or ? is a name glob,
+   name:P and tag:T say which explicitly, and /R/ is a regex.
+   Operators are !, &&, ||, and parentheses, in the usual
+   precedence.
+
+   - TestFilter parses an expression once into a tree of
+     compiled terms, globs split into literal pieces and regexes
+     built with std::regex::optimize
+   - TestIndex holds the names and tags of a test set, with
+     names sorted and a posting list of tests for each tag
+   - match() evaluates the tree a set at a time: a tag is its
+     posting list, a glob or anchored regex with a literal
+     prefix scans only the sorted names with that prefix, and
+     !, &&, and || combine bitsets a word at a time, so each
+     name is matched against each pattern at most once
+
+   Package Dependencies:
+  -----------------------
+   TestFilter.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.2 - 17 Oct 2026
+   - regex literal skips {n,m} quantifiers
+   ver 1.1 - 17 Oct 2026
+   - selector over a TestIndex, so sequencer tests match tags
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <regex>
+#include <stdexcept>
+#include <cstdint>
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // TestIndex class - names and tags of a test set
+
+  class TestIndex {
+  public:
+    /*-- add a test, tags separated by white space, returns its id --*/
+    size_t add(std::string_view name, std::string_view tags = std::string_view()) {
+      size_t id = names_.size();
+      names_.emplace_back(name);
+      size_t pos = 0;
+      while (pos < tags.size()) {
+        pos = tags.find_first_not_of(" \t,", pos);
+        if (pos == std::string_view::npos)
+          break;
+        size_t end = tags.find_first_of(" \t,", pos);
+        if (end == std::string_view::npos)
+          end = tags.size();
+        std::vector<uint32_t>& ids = tags_[std::string(tags.substr(pos, end - pos))];
+        if (ids.empty() || ids.back() != id)
+          ids.push_back(static_cast<uint32_t>(id));
+        pos = end;
+      }
+      sorted_.clear();
+      return id;
+    }
+    size_t size() const {
+      return names_.size();
+    }
+    const std::string& name(size_t id) const {
+      return names_[id];
+    }
+    /*-- ids of tests carrying tag, in id order --*/
+    const std::vector<uint32_t>& tagged(const std::string& tag) const {
+      static const std::vector<uint32_t> none;
+      auto iter = tags_.find(tag);
+      return iter == tags_.end() ? none : iter->second;
+    }
+    /*-- ids in name order, sorted on first use after adds --*/
+    const std::vector<uint32_t>& byName() const {
+      if (sorted_.size() != names_.size()) {
+        sorted_.resize(names_.size());
+        for (size_t i = 0; i < sorted_.size(); ++i)
+          sorted_[i] = static_cast<uint32_t>(i);
+        std::sort(sorted_.begin(), sorted_.end(), [this](uint32_t a, uint32_t b) { return names_[a] < names_[b]; });
+      }
+      return sorted_;
+    }
+  private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, std::vector<uint32_t>> tags_;
+    mutable std::vector<uint32_t> sorted_;
+  };
+
+  ///////////////////////////////////////////////
+  // Selection class - bitset over test ids
+
+  class Selection {
+  public:
+    explicit Selection(size_t n = 0, bool all = false)
+      : size_(n), words_((n + 63) / 64, all ? ~uint64_t(0) : 0) {
+      trim();
+    }
+    size_t size() const {
+      return size_;
+    }
+    bool operator[](size_t id) const {
+      return (words_[id / 64] >> (id % 64)) & 1;
+    }
+    void set(size_t id) {
+      words_[id / 64] |= uint64_t(1) << (id % 64);
+    }
+    Selection& operator&=(const Selection& s) {
+      for (size_t i = 0; i < words_.size(); ++i)
+        words_[i] &= s.words_[i];
+      return *this;
+    }
+    Selection& operator|=(const Selection& s) {
+      for (size_t i = 0; i < words_.size(); ++i)
+        words_[i] |= s.words_[i];
+      return *this;
+    }
+    void flip() {
+      for (auto& w : words_)
+        w = ~w;
+      trim();
+    }
+    size_t count() const {
+      size_t n = 0;
+      for (uint64_t w : words_)
+        for (; w; w &= w - 1)
+          ++n;
+      return n;
+    }
+  private:
+    void trim() {
+      if (size_ % 64 != 0 && !words_.empty())
+        words_.back() &= (uint64_t(1) << (size_ % 64)) - 1;
+    }
+    size_t size_;
+    std::vector<uint64_t> words_;
+  };
+
+  ///////////////////////////////////////////////
+  // Glob class - * and ? pattern, split at each *
+
+  class Glob {
+  public:
+    explicit Glob(const std::string& pattern = "") {
+      size_t start = 0;
+      for (size_t pos = 0; pos <= pattern.size(); ++pos) {
+        if (pos == pattern.size() || pattern[pos] == '*') {
+          pieces_.push_back(pattern.substr(start, pos - start));
+          start = pos + 1;
+        }
+      }
+      prefix_ = pattern.substr(0, pattern.find_first_of("*?"));
+    }
+    /*-- literal text every match starts with --*/
+    const std::string& prefix() const {
+      return prefix_;
+    }
+    bool matches(std::string_view s) const {
+      const std::string& first = pieces_.front();
+      if (pieces_.size() == 1)
+        return s.size() == first.size() && at(s, 0, first);
+      const std::string& last = pieces_.back();
+      if (s.size() < first.size() + last.size() || !at(s, 0, first) || !at(s, s.size() - last.size(), last))
+        return false;
+      size_t pos = first.size();
+      size_t end = s.size() - last.size();
+      for (size_t i = 1; i + 1 < pieces_.size(); ++i) {
+        pos = find(s, pos, end, pieces_[i]);
+        if (pos == std::string_view::npos)
+          return false;
+        pos += pieces_[i].size();
+      }
+      return true;
+    }
+  private:
+    /*-- piece matches s at pos, ? matching any char --*/
+    static bool at(std::string_view s, size_t pos, const std::string& piece) {
+      for (size_t i = 0; i < piece.size(); ++i)
+        if (piece[i] != '?' && piece[i] != s[pos + i])
+          return false;
+      return true;
+    }
+    /*-- leftmost match of piece in s[pos, end) --*/
+    static size_t find(std::string_view s, size_t pos, size_t end, const std::string& piece) {
+      for (; pos + piece.size() <= end; ++pos)
+        if (at(s, pos, piece))
+          return pos;
+      return std::string_view::npos;
+    }
+    std::vector<std::string> pieces_;
+    std::string prefix_;
+  };
+
+  ///////////////////////////////////////////////
+  // TestFilter class - compiled filter expression
+
+  class TestFilter {
+  public:
+    /*-- empty expression selects every test --*/
+    TestFilter() = default;
+    /*-- compile expression, throws std::invalid_argument on syntax errors --*/
+    explicit TestFilter(const std::string& expression) : text_(expression) {
+      pos_ = 0;
+      skipSpace();
+      if (pos_ == text_.size())
+        return;
+      root_ = parseOr();
+      skipSpace();
+      if (pos_ != text_.size())
+        fail("unexpected text");
+    }
+    /*-- filter selecting tests any of expressions select --*/
+    static TestFilter anyOf(const std::vector<std::string>& expressions) {
+      if (expressions.size() == 1)
+        return TestFilter(expressions.front());
+      std::string joined;
+      for (auto& e : expressions) {
+        TestFilter check(e);   // report errors against e, not the joined text
+        if (!joined.empty())
+          joined += " || ";
+        joined += "(" + e + ")";
+      }
+      return TestFilter(joined);
+    }
+    bool empty() const {
+      return root_ < 0;
+    }
+    /*-- tests of index the filter selects --*/
+    Selection match(const TestIndex& index) const {
+      if (empty())
+        return Selection(index.size(), true);
+      return eval(root_, index);
+    }
+    /*-- selector for TestSequencer::select over the tests of index --*/
+    std::function<bool(const std::string&)> selector(const TestIndex& index) const {
+      if (empty())
+        return [](const std::string&) { return true; };
+      Selection s = match(index);
+      auto pSelected = std::make_shared<std::unordered_set<std::string>>();
+      for (size_t i = 0; i < index.size(); ++i)
+        if (s[i])
+          pSelected->insert(index.name(i));
+      return [pSelected](const std::string& name) { return pSelected->count(name) > 0; };
+    }
+    /*-- selector over names, which have no tags --*/
+    std::function<bool(const std::string&)> selector(const std::vector<std::string>& names) const {
+      TestIndex index;
+      for (auto& n : names)
+        index.add(n);
+      return selector(index);
+    }
+  private:
+    struct Node {
+      enum Kind { tag, glob, regex, notOp, andOp, orOp };
+      explicit Node(Kind k) : kind(k) {}
+      Kind kind;
+      std::string text;
+      Glob pattern;
+      std::regex re;
+      std::string prefix;   // literal prefix of an anchored regex
+      std::string literal;  // text every regex match contains
+      int left = -1;
+      int right = -1;
+    };
+
+    [[noreturn]] void fail(const std::string& why) const {
+      throw std::invalid_argument("filter \"" + text_ + "\": " + why + " at column " + std::to_string(pos_ + 1));
+    }
+    void skipSpace() {
+      while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t'))
+        ++pos_;
+    }
+    bool take(const char* op) {
+      skipSpace();
+      size_t n = std::char_traits<char>::length(op);
+      if (text_.compare(pos_, n, op) != 0)
+        return false;
+      pos_ += n;
+      return true;
+    }
+    int add(Node node) {
+      nodes_.push_back(std::move(node));
+      return static_cast<int>(nodes_.size()) - 1;
+    }
+    int binary(Node::Kind kind, int left, int right) {
+      Node n(kind);
+      n.left = left;
+      n.right = right;
+      return add(std::move(n));
+    }
+    int parseOr() {
+      int left = parseAnd();
+      while (take("||"))
+        left = binary(Node::orOp, left, parseAnd());
+      return left;
+    }
+    int parseAnd() {
+      int left = parseUnary();
+      while (take("&&"))
+        left = binary(Node::andOp, left, parseUnary());
+      return left;
+    }
+    int parseUnary() {
+      if (take("!")) {
+        Node n(Node::notOp);
+        n.left = parseUnary();
+        return add(std::move(n));
+      }
+      if (take("(")) {
+        int inner = parseOr();
+        if (!take(")"))
+          fail("missing )");
+        return inner;
+      }
+      return parseTerm();
+    }
+    int parseTerm() {
+      skipSpace();
+      if (pos_ < text_.size() && text_[pos_] == '/')
+        return parseRegex();
+      size_t start = pos_;
+      while (pos_ < text_.size() && std::string_view(" \t()!&|").find(text_[pos_]) == std::string_view::npos)
+        ++pos_;
+      std::string word = text_.substr(start, pos_ - start);
+      if (word.empty())
+        fail("expected a tag, name pattern, or /regex/");
+      Node n(Node::tag);
+      if (word.rfind("tag:", 0) == 0) {
+        n.text = word.substr(4);
+      }
+      else if (word.rfind("name:", 0) == 0) {
+        n.kind = Node::glob;
+        n.text = word.substr(5);
+      }
+      else if (word.find_first_of("*?") != std::string::npos) {
+        n.kind = Node::glob;
+        n.text = word;
+      }
+      else {
+        n.text = word;
+      }
+      if (n.kind == Node::glob)
+        n.pattern = Glob(n.text);
+      return add(std::move(n));
+    }
+    int parseRegex() {
+      size_t start = ++pos_;
+      while (pos_ < text_.size() && text_[pos_] != '/')
+        pos_ += (text_[pos_] == '\\' && pos_ + 1 < text_.size()) ? 2 : 1;
+      if (pos_ >= text_.size())
+        fail("missing closing /");
+      Node n(Node::regex);
+      n.text = text_.substr(start, pos_ - start);
+      ++pos_;
+      try {
+        n.re = std::regex(n.text, std::regex::ECMAScript | std::regex::optimize);
+      }
+      catch (std::regex_error& ex) {
+        fail(std::string("bad regex, ") + ex.what());
+      }
+      n.prefix = anchoredPrefix(n.text);
+      n.literal = requiredLiteral(n.text);
+      return add(std::move(n));
+    }
+    /*-- literal text after a leading ^, that every match starts with --*/
+    static std::string anchoredPrefix(const std::string& re) {
+      if (re.empty() || re[0] != '^' || re.find('|') != std::string::npos)
+        return std::string();
+      std::string prefix;
+      for (size_t i = 1; i < re.size(); ++i) {
+        char ch = re[i];
+        if (std::string_view(".[](){}*+?|\\^$").find(ch) != std::string_view::npos) {
+          /* a quantifier may make the last literal optional */
+          if ((ch == '*' || ch == '?' || ch == '{') && !prefix.empty())
+            prefix.pop_back();
+          break;
+        }
+        prefix += ch;
+      }
+      return prefix;
+    }
+    /*---------------------------------------------------
+      longest literal run outside groups, classes, and
+      {n,m} quantifiers, which every match must contain,
+      so names without it skip the regex
+    */
+    static std::string requiredLiteral(const std::string& re) {
+      if (re.find('|') != std::string::npos)
+        return std::string();
+      std::string best, run;
+      int depth = 0;
+      auto endRun = [&]() {
+        if (run.size() > best.size())
+          best = run;
+        run.clear();
+      };
+      for (size_t i = 0; i < re.size(); ++i) {
+        char ch = re[i];
+        bool optional = i + 1 < re.size() && std::string_view("*?{").find(re[i + 1]) != std::string_view::npos;
+        if (ch == '(' || ch == ')') {
+          depth += ch == '(' ? 1 : -1;
+          endRun();
+        }
+        else if (ch == '[') {
+          endRun();
+          while (i < re.size() && re[i] != ']')
+            i += re[i] == '\\' ? 2 : 1;
+        }
+        else if (ch == '{') {
+          endRun();
+          while (i < re.size() && re[i] != '}')
+            ++i;
+        }
+        else if (depth > 0 || optional || std::string_view(".{}*+?\\^$").find(ch) != std::string_view::npos) {
+          if (ch == '\\')
+            ++i;
+          endRun();
+        }
+        else {
+          run += ch;
+          if (re.size() > i + 1 && re[i + 1] == '+')
+            endRun();
+        }
+      }
+      endRun();
+      return best;
+    }
+    /*-- apply match to names starting with prefix, all names if it's empty --*/
+    template<typename M>
+    static Selection scan(const TestIndex& index, const std::string& prefix, M match) {
+      Selection s(index.size());
+      if (prefix.empty()) {
+        for (size_t id = 0; id < index.size(); ++id)
+          if (match(index.name(id)))
+            s.set(id);
+        return s;
+      }
+      const std::vector<uint32_t>& sorted = index.byName();
+      auto iter = std::lower_bound(sorted.begin(), sorted.end(), prefix,
+        [&](uint32_t id, const std::string& p) { return index.name(id) < p; }
+      );
+      for (; iter != sorted.end() && index.name(*iter).compare(0, prefix.size(), prefix) == 0; ++iter)
+        if (match(index.name(*iter)))
+          s.set(*iter);
+      return s;
+    }
+    Selection eval(int i, const TestIndex& index) const {
+      const Node& n = nodes_[i];
+      switch (n.kind) {
+      case Node::tag: {
+        Selection s(index.size());
+        for (uint32_t id : index.tagged(n.text))
+          s.set(id);
+        return s;
+      }
+      case Node::glob:
+        return scan(index, n.pattern.prefix(), [&](const std::string& name) { return n.pattern.matches(name); });
+      case Node::regex:
+        return scan(index, n.prefix, [&](const std::string& name) {
+          return name.find(n.literal) != std::string::npos && std::regex_search(name, n.re);
+        });
+      case Node::notOp: {
+        Selection s = eval(n.left, index);
+        s.flip();
+        return s;
+      }
+      case Node::andOp: {
+        Selection s = eval(n.left, index);
+        if (s.count() > 0)
+          s &= eval(n.right, index);
+        return s;
+      }
+      default: {
+        Selection s = eval(n.left, index);
+        s |= eval(n.right, index);
+        return s;
+      }
+      }
+    }
+
+    std::string text_;
+    size_t pos_ = 0;
+    std::vector<Node> nodes_;
+    int root_ = -1;
+  };
+}
@@ -0,0 +1,211 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestGraph.h - dependency ordered parallel test runs     //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Runs tests that declare dependencies on other tests:
+   - add(name, test, dependsOn) declares a node of a directed
+     acyclic graph, test runs only after every test it depends
+     on has completed
+   - run() starts all tests with no dependencies on a ThreadPool,
+     and each completing test submits the dependents it makes
+     ready, so independent branches run in parallel
+   - a test whose dependency failed is skipped and reported as
+     failed, naming the failed dependency
+   - run() on a pool worker, e.g., a graph inside a test of a
+     parallel run, runs the tests inline in dependency order
+     instead of starting a nested pool
+   - results are kept in declaration order
+
+   Unknown dependency names and cycles are rejected by run(),
+   which throws std::invalid_argument before running any test.
+
+   Package Dependencies:
+  -----------------------
+   TestGraph.h
+   TestHarness.h
+   ThreadPool.h
+   TestCallable.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.2 - 17 Oct 2026
+   - runs inline when called on a pool worker
+   ver 1.1 - 17 Oct 2026
+   - results are buffered in a ReportBatch while tests run
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include "TestHarness.h"
+#include "ThreadPool.h"
+#include "TestCallable.h"
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // TestGraph class
+
+  class TestGraph {
+  public:
+    explicit TestGraph(const ExecutorOptions& opts = ExecutorOptions()) : opts_(opts) {}
+
+    /*-- declare test, dependencies may be declared later --*/
+    TestGraph& add(
+      const std::string& name, TestCallable test,
+      const std::vector<std::string>& dependsOn = {}
+    ) {
+      nodes_.push_back(std::make_unique<Node>());
+      Node& node = *nodes_.back();
+      node.name = name;
+      node.test = std::move(test);
+      node.dependsOn = dependsOn;
+      return *this;
+    }
+    /*---------------------------------------------------
+      run all tests on nThreads workers, zero means no
+      more than one per hardware thread
+      - returns true if every test passed
+    */
+    bool run(size_t nThreads = 0) {
+      link();
+      results_.assign(nodes_.size(), TestResult());
+      if (nodes_.empty())
+        return true;
+      Executor<ITest> ex(opts_);
+      ReportBatch batch(ex.reporter());
+      if (nThreads == 0)
+        nThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+      nThreads = std::min(nThreads, nodes_.size());
+      if (nThreads == 1 || ThreadPool::onWorker()) {
+        std::deque<size_t> ready;
+        for (size_t i = 0; i < nodes_.size(); ++i)
+          if (nodes_[i]->dependsOn.empty())
+            ready.push_back(i);
+        while (!ready.empty()) {
+          size_t i = ready.front();
+          ready.pop_front();
+          runNode(i, [&ready](size_t d) { ready.push_back(d); });
+        }
+      }
+      else {
+        ThreadPool pool(nThreads);
+        std::function<void(size_t)> release = [this, &pool, &release](size_t i) {
+          pool.submit([this, i, &release]() { runNode(i, release); });
+        };
+        for (size_t i = 0; i < nodes_.size(); ++i)
+          if (nodes_[i]->dependsOn.empty())
+            release(i);
+        pool.wait();
+      }
+      bool rtn = true;
+      for (auto& r : results_)
+        rtn &= r.passed;
+      return rtn;
+    }
+    /*-- results of most recent run, in declaration order --*/
+    const TestResults& results() const {
+      return results_;
+    }
+  private:
+    struct Node {
+      std::string name;
+      TestCallable test;
+      std::vector<std::string> dependsOn;
+      std::vector<size_t> dependents;
+      std::atomic<size_t> waitingOn{ 0 };
+      std::mutex mtx;
+      std::string failedDependency;
+    };
+    /*-- resolve names to indices, reject unknown names and cycles --*/
+    void link() {
+      std::unordered_map<std::string, size_t> index;
+      for (size_t i = 0; i < nodes_.size(); ++i)
+        index[nodes_[i]->name] = i;
+      std::vector<size_t> inDegree(nodes_.size(), 0);
+      for (size_t i = 0; i < nodes_.size(); ++i) {
+        Node& node = *nodes_[i];
+        node.dependents.clear();
+        node.failedDependency.clear();
+        inDegree[i] = node.dependsOn.size();
+        node.waitingOn = inDegree[i];
+      }
+      for (size_t i = 0; i < nodes_.size(); ++i) {
+        for (auto& dep : nodes_[i]->dependsOn) {
+          auto iter = index.find(dep);
+          if (iter == index.end())
+            throw std::invalid_argument(nodes_[i]->name + " depends on unknown test " + dep);
+          nodes_[iter->second]->dependents.push_back(i);
+        }
+      }
+      /* Kahn's algorithm, any node never reaching zero is on a cycle */
+      std::vector<size_t> ready;
+      for (size_t i = 0; i < nodes_.size(); ++i)
+        if (inDegree[i] == 0)
+          ready.push_back(i);
+      size_t visited = 0;
+      while (!ready.empty()) {
+        size_t i = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (size_t d : nodes_[i]->dependents)
+          if (--inDegree[d] == 0)
+            ready.push_back(d);
+      }
+      if (visited != nodes_.size()) {
+        for (size_t i = 0; i < nodes_.size(); ++i)
+          if (inDegree[i] > 0)
+            throw std::invalid_argument("dependency cycle through test " + nodes_[i]->name);
+      }
+    }
+    /*-- execute node, then release dependents it makes ready --*/
+    void runNode(size_t i, const std::function<void(size_t)>& release) {
+      Node& node = *nodes_[i];
+      std::string failed;
+      {
+        std::lock_guard<std::mutex> l(node.mtx);
+        failed = node.failedDependency;
+      }
+      TestResult r;
+      if (failed.empty()) {
+        Executor<ITest> ex(opts_);
+        r = ex.execute(node.test, node.name);
+      }
+      else {
+        r.name = node.name;
+        r.start = r.end = Clock::now();
+        r.message = "skipped, dependency " + failed + " failed";
+      }
+      bool passed = r.passed;
+      results_[i] = std::move(r);
+
+      for (size_t d : node.dependents) {
+        Node& dependent = *nodes_[d];
+        if (!passed) {
+          std::lock_guard<std::mutex> l(dependent.mtx);
+          if (dependent.failedDependency.empty())
+            dependent.failedDependency = node.name;
+        }
+        if (dependent.waitingOn.fetch_sub(1) == 1)
+          release(d);
+      }
+    }
+
+    std::vector<std::unique_ptr<Node>> nodes_;
+    TestResults results_;
+    ExecutorOptions opts_;
+  };
+}
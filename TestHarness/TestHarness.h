@@ -8,23 +8,150 @@
    Package Responsibilities
   --------------------------
    Executes test sequences:
-   - Executes bool test() method on each registered test class
-   - Executes bool registeredFunction() for each registered function
+   - Executes bool test() method on each registered test class,
+     classes of any type derived from the sequencer's T are held
+     in one contiguous arena, so TestSequencer<ITest> runs a whole
+     suite of different test classes
+   - Test classes registered lazily, by type with name, tags,
+     and source location, are constructed only when selected to
+     run, so listing and filtering a suite builds no fixtures
+   - Executes each registered bool() function, lambda, or function
+     object, held in a TestCallable
+   - Records name, pass/fail, exception message, and monotonic
+     start/end times of each test in a TestResult
+   - Displays results through a Reporter, buffered per thread
+     during sequencer runs
+   - Optionally attaches hardware event counts to each TestResult
+   - Optionally counts heap allocations of each test, failing tests
+     that allocate more than a configured limit
+   - Optionally records each test's peak resident set, page
+     faults, and context switches, failing tests whose peak
+     grows more than a configured limit
+   - Optionally enforces per-test and per-suite deadlines, marking
+     tests that miss them timed out and continuing with the rest
+   - Runs only selected tests, e.g., one shard of a suite
+   - Optionally orders tests by their recorded history, so
+     recent failures are reported first
+   - Benchmarks registered functions and test methods
+   - Optionally spreads registered tests over a work-stealing
+     thread pool, reporting wall time and summed cpu time
 
    Package Dependencies:
   -----------------------
    TestHarness.h
    ITest.h
+   TestClock.h
+   TestResult.h
+   Reporter.h
+   ThreadPool.h
+   TestCallable.h
+   TestArena.h
+   Watchdog.h
+   TestHistory.h
+   TestFilter.h
+   ResultStore.h
+   Benchmark.h
+   Baseline.h
+   Stress.h
+   FixtureCache.h (fixture uses per benchmark or stress run)
+   PerfCounters.h
+   ResourceUsage.h
+   AllocTracker.h, AllocTracker.cpp (only for allocation counts)
+   TestAssertions.h (failure slot)
 
    Maintenance History:
   ----------------------
+   ver 1.23 - 17 Oct 2026
+   - doTests batches each test's reports on their own, so a result
+     is written before the next test's output, only parallel runs
+     batch the whole run
+   ver 1.22 - 17 Oct 2026
+   - RunnerSlot is a plain result holder, Executor::execute can
+     hand back its notes instead of reporting them
+   ver 1.21 - 17 Oct 2026
+   - peak resident set limit isn't applied to tests that ran
+     concurrently with other measured tests
+   ver 1.20 - 17 Oct 2026
+   - a test run on a runner thread reports into its own shared
+     slot, whose late writes are dropped once it is abandoned
+   ver 1.19 - 17 Oct 2026
+   - each benchmark and stress run of a test is one FixtureRun
+   ver 1.18 - 17 Oct 2026
+   - doTests batches its reports, benchmark and stress summaries
+     go to the sequencer's reporter
+   ver 1.17 - 17 Oct 2026
+   - added TestSequencer::regLazy, list, and index
+   ver 1.16 - 17 Oct 2026
+   - added per-test resource usage and peak resident set limit
+   ver 1.15 - 17 Oct 2026
+   - added TestSequencer::doStress
+   ver 1.14 - 17 Oct 2026
+   - a failed TEST_CHECK fails the test and explains why
+   ver 1.13 - 17 Oct 2026
+   - TestSequencer::baseline fails benchmarks that regress
+   ver 1.12 - 17 Oct 2026
+   - TestSequencer::store appends results to a ResultStore
+   ver 1.11 - 17 Oct 2026
+   - results and notices go to a Reporter instead of std::cout,
+     TestResult and ExecutorOptions moved to TestResult.h
+   ver 1.10 - 17 Oct 2026
+   - added history driven test ordering
+   ver 1.9 - 17 Oct 2026
+   - added test and suite timeouts enforced by a Watchdog
+   ver 1.8 - 17 Oct 2026
+   - test classes derived from T are stored in a TestArena
+   ver 1.7 - 17 Oct 2026
+   - registered functions are held in TestCallable, so capturing
+     lambdas can be registered without heap allocation
+   ver 1.6 - 17 Oct 2026
+   - added test selection and durations export for sharding
+   ver 1.5 - 17 Oct 2026
+   - added per-test allocation accounting and allocation limit
+   ver 1.4 - 17 Oct 2026
+   - added ExecutorOptions, with per-test perf_event counters
+   ver 1.3 - 17 Oct 2026
+   - added Executor::benchmark and TestSequencer::doBenchmarks
+   ver 1.2 - 17 Oct 2026
+   - Executor::doTest returns TestResult records, collected
+     by TestSequencer for sorting, filtering, and export
+   ver 1.1 - 17 Oct 2026
+   - added TestSequencer::doTestsParallel()
    ver 1.0 - 25 Jan 2020
    - first release
 */
 #include <string>
 #include <vector>
 #include <iostream>
+#include <sstream>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <exception>
+#include <optional>
+#include <limits>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
 #include "ITest.h"
+#include "TestClock.h"
+#include "TestResult.h"
+#include "Reporter.h"
+#include "ThreadPool.h"
+#include "TestCallable.h"
+#include "TestArena.h"
+#include "Watchdog.h"
+#include "TestHistory.h"
+#include "TestFilter.h"
+#include "ResultStore.h"
+#include "Benchmark.h"
+#include "Baseline.h"
+#include "Stress.h"
+#include "FixtureCache.h"
+#include "PerfCounters.h"
+#include "AllocTracker.h"
+#include "../TestUtilities/TestAssertions.h"
 
 namespace Test {
 
@@ -35,7 +162,6 @@ namespace Test {
   /*-- function pointer type declaration --*/
   using FP = bool(*)();
 
-
   ///////////////////////////////////////////////
   // Executor class
 
@@ -43,86 +169,706 @@ namespace Test {
   class Executor {
   public:
     Executor() = default;
+    explicit Executor(const ExecutorOptions& opts) : opts_(opts) {}
 
     /*-- execute test class instance's test method --*/
 
-    bool doTest(MP<T> tp, T* pT) {
-      bool result = false;
-      try {
-        result = (pT->*tp)();
-      }
-      catch (...) {
-        std::cout << "\n  exception thrown";
-        result = false;
-      }
-      return result;
+    TestResult doTest(MP<T> tp, T* pT, const std::string& name = "") {
+      return execute([tp, pT]() { return (pT->*tp)(); }, name);
     }
     /*-- execute test function --*/
 
-    bool doTest(FP fp) {
-      bool result = false;
+    TestResult doTest(FP fp, const std::string& name = "") {
+      return execute(fp, name);
+    }
+    /*-- execute any callable returning bool, timing it --*/
+
+    template<typename F>
+    TestResult execute(F&& f, const std::string& name = "") {
+      std::string note;
+      TestResult result = execute(std::forward<F>(f), name, note);
+      if (!note.empty())
+        reporter().note(note);
+      return result;
+    }
+    /*-- execute, leaving any notice in note instead of reporting it --*/
+
+    template<typename F>
+    TestResult execute(F&& f, const std::string& name, std::string& note) {
+      TestResult result;
+      result.name = name;
+      PerfGroup* pCounters = opts_.counters ? &PerfGroup::forThisThread() : nullptr;
+      ResourceMeter meter;
+      if (opts_.resources)
+        meter.start();
+      result.start = Clock::now();
+      Nanoseconds cpuStart = threadCpuTime();
+      if (pCounters)
+        pCounters->start();
+      std::optional<AllocScope> allocScope;
+      auto takeAllocStats = [&]() {
+        if (allocScope) {
+          result.allocations = allocScope->stats();
+          allocScope.reset();
+        }
+      };
+      if (opts_.allocations)
+        allocScope.emplace();
+      FailureScope failure;
       try {
-        result = fp();
+        result.passed = f();
+        takeAllocStats();
+        if (failure.failed()) {
+          result.passed = false;
+          result.message = failure.message();
+        }
+      }
+      catch (std::exception& ex) {
+        takeAllocStats();
+        note = "exception thrown";
+        result.passed = false;
+        result.message = ex.what();
       }
       catch (...) {
-        std::cout << "\n  exception thrown";
-        result = false;
+        takeAllocStats();
+        note = "exception thrown";
+        result.passed = false;
+        result.message = "unknown exception";
+      }
+      if (pCounters)
+        result.counters = pCounters->stop();
+      result.cpuTime = threadCpuTime() - cpuStart;
+      result.end = Clock::now();
+      if (opts_.resources)
+        result.resources = meter.stop();
+      if (opts_.allocations && result.allocations.allocations > opts_.maxAllocations) {
+        result.passed = false;
+        result.message = std::to_string(result.allocations.allocations)
+          + " allocations exceed limit of " + std::to_string(opts_.maxAllocations);
+      }
+      /* a concurrent peak may be another test's, see ResourceUsage.h */
+      if (opts_.resources && !result.resources.concurrent && result.resources.peakRssBytes > opts_.maxPeakRss) {
+        result.passed = false;
+        result.message = "peak resident set grew " + std::to_string(result.resources.peakRssBytes)
+          + " bytes, limit is " + std::to_string(opts_.maxPeakRss);
       }
       return result;
     }
+    /*-- time test class instance's test method repeatedly --*/
+
+    BenchmarkResult benchmark(
+      MP<T> tp, T* pT, const std::string& name, const BenchmarkOptions& opts = BenchmarkOptions()
+    ) {
+      return Test::benchmark([tp, pT]() { return (pT->*tp)(); }, name, opts);
+    }
+    /*-- time test function repeatedly --*/
+
+    BenchmarkResult benchmark(
+      FP fp, const std::string& name, const BenchmarkOptions& opts = BenchmarkOptions()
+    ) {
+      return Test::benchmark(fp, name, opts);
+    }
     /*-- report results to avoid repetition in test code --*/
 
     void showResult(bool r, const std::string& name) {
-      if (r) {
-        std::cout << "\n  " << name << " passed";
-      }
-      else {
-        std::cout << "\n  " << name << " failed";
-      }
+      TestResult result;
+      result.name = name;
+      result.passed = r;
+      result.start = result.end = Clock::now();
+      reporter().report(result);
+    }
+    /*-- report result record --*/
+
+    void showResult(const TestResult& r) {
+      reporter().report(r, opts_);
+    }
+    /*-- where results are displayed --*/
+
+    Reporter& reporter() const {
+      return opts_.reporter ? *opts_.reporter : defaultReporter();
     }
+  private:
+    ExecutorOptions opts_;
   };
 
-  /*-- define collection of test class instances --*/
+  /*-- define collection of test class instances, stored in a TestArena --*/
   template<typename T>
-  using ClassTests = std::vector<T>;
+  using ClassTests = std::vector<T*>;
+
+  /*-- define collection of test callables --*/
+  using FunctionTests = std::vector<std::pair<TestCallable, std::string>>;
+
+  /*-- where a test is declared, see TEST_HERE --*/
+  struct TestLocation {
+    const char* file = "";
+    int line = 0;
+  };
+
+  /*-- what is known about a registered test without running it --*/
+  struct TestInfo {
+    std::string name;
+    std::string tags;
+    TestLocation location;
+  };
+
+  /*-- elapsed times of the most recent test run --*/
+  struct RunTiming {
+    double wallMicroseconds = 0.0;
+    double cpuMicroseconds = 0.0;
+    size_t threads = 1;
+  };
 
-  /*-- define collection of test function pointers --*/
-  using FunctionTests = std::vector<std::pair<FP, std::string>>;
+  namespace detail {
+
+    ///////////////////////////////////////////////
+    // RunnerSlot class - result of one runner job
+
+    /*
+       Owned jointly by the sequencer and the runner's job, so a
+       job abandoned at its deadline writes only here, never into
+       the sequencer's results or reporter.  Writes after
+       abandon() are dropped.
+    */
+    class RunnerSlot {
+    public:
+      void store(TestResult r, std::string note) {
+        std::lock_guard<std::mutex> l(mtx_);
+        if (abandoned_)
+          return;
+        result_ = std::move(r);
+        note_ = std::move(note);
+      }
+      /*-- result of a job that finished, and its notice, if any --*/
+      TestResult take(std::string& note) {
+        std::lock_guard<std::mutex> l(mtx_);
+        note.swap(note_);
+        return std::move(result_);
+      }
+      void abandon() {
+        std::lock_guard<std::mutex> l(mtx_);
+        abandoned_ = true;
+      }
+    private:
+      std::mutex mtx_;
+      bool abandoned_ = false;
+      TestResult result_;
+      std::string note_;
+    };
+  }
 
   template<typename T>
   class TestSequencer {
   public:
-    /*-- register test class --*/
-    void reg(T& t) {
-      ctests_.push_back(std::move(t));
+    TestSequencer() = default;
+    TestSequencer(const TestSequencer&) = delete;
+    TestSequencer& operator=(const TestSequencer&) = delete;
+    /*-- measurements taken for each test --*/
+    void options(const ExecutorOptions& opts) {
+      opts_ = opts;
+    }
+    const ExecutorOptions& options() const {
+      return opts_;
+    }
+    /*-- register test class, moving it into the arena --*/
+    template<typename U>
+    void reg(U& t) {
+      static_assert(std::is_base_of_v<T, U>, "test class must derive from sequencer's T");
+      ctests_.push_back(arena_.emplace<U>(std::move(t)));
+    }
+    /*-- construct test class in place in the arena --*/
+    template<typename U, typename... Args>
+    U& emplace(Args&&... args) {
+      static_assert(std::is_base_of_v<T, U>, "test class must derive from sequencer's T");
+      U* pU = arena_.emplace<U>(std::forward<Args>(args)...);
+      ctests_.push_back(pU);
+      return *pU;
+    }
+    /*---------------------------------------------------
+      register default constructible test class U by
+      type, it is constructed in the arena when first
+      selected to run
+      - name, tags, and location are all that list(),
+        names(), index(), and select() see, so they build
+        no fixture
+    */
+    template<typename U>
+    void regLazy(const std::string& name, const std::string& tags = "", TestLocation where = TestLocation()) {
+      static_assert(std::is_base_of_v<T, U>, "test class must derive from sequencer's T");
+      static_assert(std::is_default_constructible_v<U>, "lazily registered test class must be default constructible");
+      ltests_.push_back(LazyTest{ TestInfo{ name, tags, where }, [](TestArena& arena) -> T* {
+        return arena.emplace<U>();
+      } });
+    }
+    /*-- register test function, lambda, or function object --*/
+    void reg(TestCallable t, const std::string& name, const std::string& tags = "", TestLocation where = TestLocation()) {
+      ftests_.emplace_back(std::move(t), name);
+      finfo_.push_back(TestInfo{ name, tags, where });
+    }
+    /*---------------------------------------------------
+      names of all registered tests, in registration
+      order, functions, then constructed classes, then
+      lazily registered classes
+    */
+    std::vector<std::string> names() {
+      std::vector<std::string> all;
+      for (auto& info : list())
+        all.push_back(std::move(info.name));
+      return all;
+    }
+    /*-- names, tags, and locations of all registered tests, in names() order --*/
+    std::vector<TestInfo> list() {
+      std::vector<TestInfo> all(finfo_);
+      for (T* pT : ctests_)
+        all.push_back(TestInfo{ pT->name(), "", TestLocation() });
+      for (auto& lazy : ltests_)
+        all.push_back(lazy.info);
+      return all;
+    }
+    /*-- names and tags of all registered tests, for TestFilter --*/
+    TestIndex index() {
+      TestIndex idx;
+      for (auto& info : list())
+        idx.add(info.name, info.tags);
+      return idx;
     }
-    /*-- register test function --*/
-    void reg(FP t, const std::string& name) {
-      ftests_.push_back(std::pair{ t, name });
+    /*-- deadline for one test, overrides ExecutorOptions::testTimeout --*/
+    void timeout(const std::string& name, Nanoseconds limit) {
+      timeouts_[name] = limit;
     }
-    /*-- execute all registered tests --*/
+    /*-- run only tests whose names satisfy selector, e.g., a shard --*/
+    void select(std::function<bool(const std::string&)> selector) {
+      selector_ = std::move(selector);
+    }
+    /*---------------------------------------------------
+      order runs by the history kept in file path, and
+      update the file after each run, see TestHistory.h
+      - an empty path turns history off
+    */
+    void history(const std::string& path) {
+      historyPath_ = path;
+    }
+    /*---------------------------------------------------
+      append each run's results to the binary store at
+      path, see ResultStore.h
+      - an empty path turns the store off
+    */
+    void store(const std::string& path) {
+      storePath_ = path;
+    }
+    /*---------------------------------------------------
+      execute all registered tests
+      - each test's reports are batched and written when it
+        ends, so they stay ahead of output of later tests
+    */
     bool doTests() {
-      Executor<T> ex;
+      Executor<T> ex(opts_);
+      std::vector<Job> jobs = plan(false);
+      std::optional<DeadlineRunner> runner;
+      if (timeoutsEnabled())
+        runner.emplace();
+      Clock::time_point suiteDeadline = suiteDeadlineFrom(Clock::now());
+      results_.clear();
+      bool rtn = true;
+      for (auto& job : jobs) {
+        ReportBatch batch(ex.reporter());
+        TestResult r = runJob(ex, job, runner, suiteDeadline);
+        ex.showResult(r);
+        rtn &= r.passed;
+        results_.push_back(std::move(r));
+      }
+      saveHistory();
+      saveStore();
+      return rtn;
+    }
+    /*---------------------------------------------------
+      gate benchmarks on the baseline kept in file path,
+      see Baseline.h
+      - a benchmark that regresses fails
+      - an empty path turns gating off
+    */
+    void baseline(const std::string& path, const RegressionOptions& opts = RegressionOptions()) {
+      baselinePath_ = path;
+      regressionOpts_ = opts;
+    }
+    /*---------------------------------------------------
+      benchmark each registered test function
+      - test classes are not benchmarked, use
+        Executor::benchmark on their test methods
+    */
+    bool doBenchmarks(const BenchmarkOptions& opts = BenchmarkOptions()) {
+      benchmarks_.clear();
+      regressions_.clear();
+      Baseline base;
+      if (!baselinePath_.empty())
+        base.load(baselinePath_);
       bool rtn = true;
-      for (auto t : ftests_) {
-        bool r = ex.doTest(t.first);
-        ex.showResult(r, t.second);
-        rtn &= r;
+      for (auto& t : ftests_) {
+        if (!selected(t.second))
+          continue;
+        BenchmarkResult r;
+        {
+          FixtureRun run;   // all iterations share the test's fixtures
+          r = Test::benchmark(t.first, t.second, opts);
+        }
+        if (!baselinePath_.empty()) {
+          Regression g = base.compare(r, regressionOpts_);
+          if (g.regressed) {
+            r.passed = false;
+            r.message = "regressed, " + g.message;
+          }
+          regressions_.push_back(std::move(g));
+        }
+        showBenchmark(r, Executor<T>(opts_).reporter());
+        rtn &= r.passed;
+        benchmarks_.push_back(std::move(r));
       }
-      for (auto& t : ctests_) {
-        bool r = t.test();
-        ex.showResult(r, t.name());
-        rtn &= r;
+      saveBaseline(base);
+      return rtn;
+    }
+    /*-- summaries of most recent doBenchmarks() --*/
+    const std::vector<BenchmarkResult>& benchmarks() const {
+      return benchmarks_;
+    }
+    /*---------------------------------------------------
+      call each registered test function from many
+      threads at once, see Stress.h
+      - test classes are not stressed, their test()
+        usually isn't meant to run concurrently
+    */
+    bool doStress(const StressOptions& opts = StressOptions()) {
+      stress_.clear();
+      bool rtn = true;
+      for (auto& t : ftests_) {
+        if (!selected(t.second))
+          continue;
+        StressResult r;
+        {
+          FixtureRun run;   // all threads share the test's fixtures
+          auto body = [&t, pRun = &run]() {
+            FixtureRun::Attach attached(pRun);
+            return t.first();
+          };
+          r = Test::stress(body, t.second, opts);
+        }
+        showStress(r, Executor<T>(opts_).reporter());
+        rtn &= r.passed;
+        stress_.push_back(std::move(r));
       }
       return rtn;
     }
+    /*-- runs of most recent doStress() --*/
+    const std::vector<StressResult>& stressResults() const {
+      return stress_;
+    }
+    /*-- baseline comparisons of most recent doBenchmarks() --*/
+    const std::vector<Regression>& regressions() const {
+      return regressions_;
+    }
+    /*---------------------------------------------------
+      execute all registered tests on a work-stealing
+      pool of nThreads workers, zero means one per
+      hardware thread
+      - results are displayed in submission order
+        after all tests complete
+    */
+    bool doTestsParallel(size_t nThreads = 0) {
+      Executor<T> ex(opts_);
+      ReportBatch batch(ex.reporter());
+      std::vector<Job> jobs = plan(true);
+      results_.clear();
+      results_.resize(jobs.size());
+      std::optional<DeadlineRunner> runner;
+      if (timeoutsEnabled())
+        runner.emplace();
+      auto wallStart = Clock::now();
+      Clock::time_point suiteDeadline = suiteDeadlineFrom(wallStart);
+      {
+        ThreadPool pool(nThreads);
+        timing_.threads = pool.size();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+          pool.submit([&, i]() {
+            results_[i] = runJob(ex, jobs[i], runner, suiteDeadline);
+          });
+        }
+        pool.wait();
+      }
+      timing_.wallMicroseconds = microseconds(Clock::now() - wallStart);
+
+      bool rtn = true;
+      Nanoseconds cpu{ 0 };
+      for (auto& r : results_) {
+        ex.showResult(r);
+        rtn &= r.passed;
+        cpu += r.cpuTime;
+      }
+      timing_.cpuMicroseconds = microseconds(cpu);
+      std::ostringstream timing;
+      timing << timing_.threads << " threads, wall time: "
+        << timing_.wallMicroseconds << " us, cpu time: "
+        << timing_.cpuMicroseconds << " us";
+      ex.reporter().note(timing.str());
+      saveHistory();
+      saveStore();
+      return rtn;
+    }
+    /*-- timing of most recent parallel run --*/
+    RunTiming timing() const {
+      return timing_;
+    }
+    /*-- result records of most recent run, in the order tests started --*/
+    const TestResults& results() const {
+      return results_;
+    }
+    /*-- records of failed tests --*/
+    TestResults failures() const {
+      TestResults failed;
+      std::copy_if(
+        results_.begin(), results_.end(), std::back_inserter(failed),
+        [](const TestResult& r) { return !r.passed; }
+      );
+      return failed;
+    }
+    /*-- the n longest running tests, longest first --*/
+    TestResults slowest(size_t n) const {
+      TestResults sorted = results_;
+      std::sort(
+        sorted.begin(), sorted.end(),
+        [](const TestResult& a, const TestResult& b) { return a.duration() > b.duration(); }
+      );
+      if (sorted.size() > n)
+        sorted.resize(n);
+      return sorted;
+    }
+    /*---------------------------------------------------
+      write results as comma separated values
+      - times are nanoseconds, start relative to the
+        earliest start in the run
+    */
+    void writeResults(std::ostream& out, const TestResults& results) const {
+      Clock::time_point origin = Clock::time_point::max();
+      for (auto& r : results)
+        origin = std::min(origin, r.start);
+      out << "name,passed,start_ns,duration_ns,cpu_ns,message\n";
+      for (auto& r : results) {
+        std::string msg = r.message;
+        for (size_t pos = msg.find('"'); pos != std::string::npos; pos = msg.find('"', pos + 2))
+          msg.insert(pos, 1, '"');
+        out << r.name << "," << (r.passed ? "true" : "false") << ","
+          << std::chrono::duration_cast<Nanoseconds>(r.start - origin).count() << ","
+          << r.duration().count() << "," << r.cpuTime.count() << ",\""
+          << msg << "\"\n";
+      }
+    }
+    void writeResults(std::ostream& out) const {
+      writeResults(out, results_);
+    }
+    /*-- write "<microseconds> <name>" lines, read by Sharding.h --*/
+    void writeDurations(std::ostream& out) const {
+      for (auto& r : results_)
+        out << microseconds(r.duration()) << " " << r.name << "\n";
+    }
   private:
+    /*-- lazily registered test class, pT is null until it first runs --*/
+    struct LazyTest {
+      TestInfo info;
+      T* (*create)(TestArena&) = nullptr;
+      T* pT = nullptr;
+    };
+    /*-- one selected test, a registered callable, a test class, or a lazy one --*/
+    struct Job {
+      std::string name;
+      TestCallable* pC = nullptr;
+      T* pT = nullptr;
+      LazyTest* pL = nullptr;
+    };
+    /*---------------------------------------------------
+      selected tests in registration order, functions
+      first, or reordered by history if one is kept
+    */
+    std::vector<Job> plan(bool longestFirst) {
+      std::vector<Job> jobs;
+      for (auto& t : ftests_)
+        if (selected(t.second))
+          jobs.push_back(Job{ t.second, &t.first, nullptr });
+      for (T* pT : ctests_)
+        if (selected(pT->name()))
+          jobs.push_back(Job{ pT->name(), nullptr, pT });
+      for (auto& lazy : ltests_)
+        if (selected(lazy.info.name))
+          jobs.push_back(Job{ lazy.info.name, nullptr, nullptr, &lazy });
+      if (historyPath_.empty())
+        return jobs;
+      history_ = TestHistory();
+      history_.load(historyPath_);
+      std::vector<std::string> names;
+      for (auto& job : jobs)
+        names.push_back(job.name);
+      std::vector<Job> ordered;
+      for (size_t i : history_.order(names, longestFirst))
+        ordered.push_back(std::move(jobs[i]));
+      return ordered;
+    }
+    TestResult runJob(
+      const Executor<T>& ex, const Job& job,
+      std::optional<DeadlineRunner>& runner, Clock::time_point suiteDeadline
+    ) {
+      if (job.pC) {
+        TestCallable* pC = job.pC;
+        return runOne(ex, [pC]() { return (*pC)(); }, job.name, runner, suiteDeadline);
+      }
+      if (job.pL) {
+        LazyTest* pL = job.pL;
+        return runOne(ex, [this, pL]() { return construct(*pL)->test(); }, job.name, runner, suiteDeadline);
+      }
+      T* pT = job.pT;
+      return runOne(ex, [pT]() { return pT->test(); }, job.name, runner, suiteDeadline);
+    }
+    /*---------------------------------------------------
+      construct lazy test class on its first run, inside
+      the test, so a throwing constructor fails the test
+      - parallel runs may construct concurrently, the
+        arena is not thread safe
+    */
+    T* construct(LazyTest& lazy) {
+      std::lock_guard<std::mutex> l(arenaMtx_);
+      if (!lazy.pT)
+        lazy.pT = lazy.create(arena_);
+      return lazy.pT;
+    }
+    /*-- add results of this run to history, if one is kept --*/
+    void saveHistory() {
+      if (historyPath_.empty())
+        return;
+      for (auto& r : results_)
+        history_.record(r.name, r.passed, microseconds(r.duration()));
+      history_.save(historyPath_);
+    }
+    /*---------------------------------------------------
+      record benchmarks that have no baseline yet, or all
+      passing ones if updating, regressions are kept out
+      unless updating
+    */
+    void saveBaseline(Baseline& base) {
+      if (baselinePath_.empty())
+        return;
+      bool changed = false;
+      for (size_t i = 0; i < benchmarks_.size(); ++i) {
+        const BenchmarkResult& r = benchmarks_[i];
+        bool regressed = regressions_[i].regressed;
+        if (!r.passed && !(regressed && regressionOpts_.update))
+          continue;
+        if (regressionOpts_.update || !base.find(r.name)) {
+          base.record(r);
+          changed = true;
+        }
+      }
+      if (changed)
+        base.save(baselinePath_);
+    }
+    /*-- append results of this run to store, if one is kept --*/
+    void saveStore() {
+      if (storePath_.empty())
+        return;
+      ResultStoreWriter writer;
+      if (!writer.open(storePath_)) {
+        Executor<T>(opts_).reporter().note("can't open result store " + storePath_);
+        return;
+      }
+      writer.append(results_);
+    }
+    bool selected(const std::string& name) const {
+      return !selector_ || selector_(name);
+    }
+    bool timeoutsEnabled() const {
+      return opts_.testTimeout.count() > 0 || opts_.suiteTimeout.count() > 0 || !timeouts_.empty();
+    }
+    Clock::time_point suiteDeadlineFrom(Clock::time_point start) const {
+      if (opts_.suiteTimeout.count() > 0)
+        return start + opts_.suiteTimeout;
+      return Clock::time_point::max();
+    }
+    /*---------------------------------------------------
+      execute one test, on a runner thread if deadlines
+      are enforced
+      - a test that misses its deadline is reported as
+        timed out and its runner is abandoned, see
+        Watchdog.h
+      - the runner stores into its own RunnerSlot, and
+        its notice is passed on to the sequencer's
+        reporter only if it finished
+    */
+    template<typename F>
+    TestResult runOne(
+      const Executor<T>& ex, F f, const std::string& name,
+      std::optional<DeadlineRunner>& runner, Clock::time_point suiteDeadline
+    ) {
+      if (!runner)
+        return Executor<T>(ex).execute(f, name);
+
+      TestResult r;
+      r.name = name;
+      r.start = Clock::now();
+      Nanoseconds limit = opts_.testTimeout;
+      auto iter = timeouts_.find(name);
+      if (iter != timeouts_.end())
+        limit = iter->second;
+      Clock::time_point deadline = suiteDeadline;
+      if (limit.count() > 0 && r.start + limit < deadline)
+        deadline = r.start + limit;
+      if (r.start >= deadline) {
+        r.timedOut = true;
+        r.message = "suite deadline passed before test started";
+        r.end = r.start;
+        return r;
+      }
+      auto pSlot = std::make_shared<detail::RunnerSlot>();
+      bool finished = runner->run(
+        [runnerEx = Executor<T>(ex), f, name, pSlot]() mutable {
+          std::string note;
+          TestResult done = runnerEx.execute(f, name, note);
+          pSlot->store(std::move(done), std::move(note));
+        }, deadline
+      );
+      if (finished) {
+        std::string note;
+        TestResult done = pSlot->take(note);
+        if (!note.empty())
+          ex.reporter().note(note);
+        return done;
+      }
+      pSlot->abandon();
+      r.end = Clock::now();
+      r.timedOut = true;
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(r.end - r.start);
+      r.message = "timed out after " + std::to_string(ms.count()) + " ms";
+      return r;
+    }
+    TestArena arena_;
     ClassTests<T> ctests_;
+    std::vector<LazyTest> ltests_;
+    std::mutex arenaMtx_;
     FunctionTests ftests_;
+    std::vector<TestInfo> finfo_;   // parallels ftests_
+    RunTiming timing_;
+    TestResults results_;
+    std::vector<BenchmarkResult> benchmarks_;
+    std::vector<Regression> regressions_;
+    std::vector<StressResult> stress_;
+    ExecutorOptions opts_;
+    std::function<bool(const std::string&)> selector_;
+    std::unordered_map<std::string, Nanoseconds> timeouts_;
+    std::string historyPath_;
+    TestHistory history_;
+    std::string storePath_;
+    std::string baselinePath_;
+    RegressionOptions regressionOpts_;
   };
 
   /*-- display helper for function tests --*/
   inline void results(bool result, const std::string& msg = "") {
-    std::cout << "\n  " << msg << " passed : " << result;
+    Executor<ITest>().showResult(result, msg);
   }
-}
\ No newline at end of file
+}
+
+/*-- source location of the registering line, e.g., seq.regLazy<T>("T", "fast", TEST_HERE) --*/
+#define TEST_HERE ::Test::TestLocation{ __FILE__, __LINE__ }
@@ -0,0 +1,166 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestHistory.h - per-test history for run ordering       //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Keeps a small on-disk record of each test's past runs:
+   - exponentially weighted mean duration, so one slow run
+     doesn't dominate
+   - number of runs and failures, and runs since last failure
+   - order() sorts a serial run so failures show up early:
+     tests that failed recently run first, most recent first,
+     then tests with no history, which are likely new or
+     changed, then the rest, shortest first within each group
+   - a parallel run starts the longest tests first, so they
+     don't straggle at the end, and uses those groups only to
+     break ties; the short tests that follow are spread over
+     all threads, so their failures still show up early
+
+   History file format, one test per line:
+     <runs> <failures> <runs since failure, -1 if never> <mean us> <test name>
+
+   Package Dependencies:
+  -----------------------
+   TestHistory.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.1 - 17 Oct 2026
+   - parallel runs start longest tests first across all groups
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <limits>
+
+namespace Test {
+
+  /*-- what is known about one test from earlier runs --*/
+  struct TestRecord {
+    static constexpr size_t neverFailed = std::numeric_limits<size_t>::max();
+
+    double meanMicroseconds = 0.0;
+    size_t runs = 0;
+    size_t failures = 0;
+    size_t runsSinceFailure = neverFailed;   // zero means failed last run
+  };
+
+  ///////////////////////////////////////////////
+  // TestHistory class
+
+  class TestHistory {
+  public:
+    static constexpr double weight = 0.3;   // of newest duration in the mean
+    static constexpr size_t recentRuns = 3; // failures this recent run first
+
+    /*-- read history file, returns false if file can't be opened --*/
+    bool load(const std::string& path) {
+      std::ifstream in(path);
+      if (!in.good())
+        return false;
+      std::string line;
+      while (std::getline(in, line)) {
+        std::istringstream ln(line);
+        TestRecord rec;
+        long long since = -1;
+        if (!(ln >> rec.runs >> rec.failures >> since >> rec.meanMicroseconds))
+          continue;
+        rec.runsSinceFailure = since < 0 ? TestRecord::neverFailed : static_cast<size_t>(since);
+        std::string name;
+        ln >> std::ws;
+        std::getline(ln, name);
+        if (!name.empty())
+          records_[name] = rec;
+      }
+      return true;
+    }
+    /*-- write history, replacing file only after a complete write --*/
+    bool save(const std::string& path) const {
+      std::string temp = path + ".tmp";
+      {
+        std::ofstream out(temp);
+        if (!out.good())
+          return false;
+        for (auto& item : records_) {
+          const TestRecord& rec = item.second;
+          long long since = rec.runsSinceFailure == TestRecord::neverFailed
+            ? -1 : static_cast<long long>(rec.runsSinceFailure);
+          out << rec.runs << " " << rec.failures << " " << since << " "
+            << rec.meanMicroseconds << " " << item.first << "\n";
+        }
+        if (!out.good())
+          return false;
+      }
+      std::remove(path.c_str());
+      return std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+    /*-- add the outcome of one run of a test --*/
+    void record(const std::string& name, bool passed, double microseconds) {
+      TestRecord& rec = records_[name];
+      if (rec.runs == 0)
+        rec.meanMicroseconds = microseconds;
+      else
+        rec.meanMicroseconds = weight * microseconds + (1.0 - weight) * rec.meanMicroseconds;
+      ++rec.runs;
+      if (!passed) {
+        ++rec.failures;
+        rec.runsSinceFailure = 0;
+      }
+      else if (rec.runsSinceFailure != TestRecord::neverFailed) {
+        ++rec.runsSinceFailure;
+      }
+    }
+    /*-- record for name, or nullptr if it has never run --*/
+    const TestRecord* find(const std::string& name) const {
+      auto iter = records_.find(name);
+      return iter == records_.end() ? nullptr : &iter->second;
+    }
+    /*---------------------------------------------------
+      return indices of names in the order they should run
+      - longestFirst for parallel runs, group and
+        recency first, then shortest, otherwise
+      - ties keep registration order
+    */
+    std::vector<size_t> order(const std::vector<std::string>& names, bool longestFirst) const {
+      struct Key { int group; size_t since; double us; };
+      std::vector<Key> keys;
+      keys.reserve(names.size());
+      for (auto& name : names) {
+        const TestRecord* pRec = find(name);
+        if (!pRec)
+          keys.push_back(Key{ 1, 0, 0.0 });
+        else if (pRec->runsSinceFailure < recentRuns)
+          keys.push_back(Key{ 0, pRec->runsSinceFailure, pRec->meanMicroseconds });
+        else
+          keys.push_back(Key{ 2, 0, pRec->meanMicroseconds });
+      }
+      std::vector<size_t> idx(names.size());
+      std::iota(idx.begin(), idx.end(), size_t(0));
+      std::stable_sort(idx.begin(), idx.end(), [&](size_t a, size_t b) {
+        const Key& ka = keys[a];
+        const Key& kb = keys[b];
+        if (longestFirst && ka.us != kb.us) return ka.us > kb.us;
+        if (ka.group != kb.group) return ka.group < kb.group;
+        if (ka.since != kb.since) return ka.since < kb.since;
+        return ka.us < kb.us;
+      });
+      return idx;
+    }
+    size_t size() const {
+      return records_.size();
+    }
+  private:
+    std::map<std::string, TestRecord> records_;
+  };
+}
@@ -0,0 +1,175 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestOptions.h - command line options for TestExecutive  //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Parses test executive command lines.  Options may be written
+   as --name=value or --name value:
+   --shard-index=N        zero based index of this shard
+   --shard-count=M        number of shards, default 1
+   --shard-durations=F    durations file used to balance shards
+   --write-durations=F    write durations of this run to F
+   --history=F            order tests by history file F, updating it
+   --store=F              append results to binary result store F
+   --baseline=F           fail benchmarks that regress from baseline F
+   --update-baseline      replace baseline records with this run
+   --filter=X             run tests selected by filter expression X,
+                          see TestFilter.h, repeat to select more
+   --stress=N,M,...       also stress test functions on N, M, ... threads
+   --stress-iterations=I  calls per thread, default 1000
+   --fuzz=T               fuzz target T instead of running tests
+   --fuzz-runs=N          inputs to try, default 100000
+   --corpus=D             fuzz corpus directory
+   --list                 list names, tags, and locations of selected
+                          tests, without constructing them, and exit
+   --reporter=R           console (default), jsonl, or junit
+   --report-file=F        write reports to F instead of std::cout
+
+   Throws std::invalid_argument for unknown options and bad values.
+
+   Package Dependencies:
+  -----------------------
+   TestOptions.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.8 - 17 Oct 2026
+   - added --list
+   ver 1.7 - 17 Oct 2026
+   - added --stress and --stress-iterations
+   ver 1.6 - 17 Oct 2026
+   - added --filter
+   ver 1.5 - 17 Oct 2026
+   - added --baseline and --update-baseline
+   ver 1.4 - 17 Oct 2026
+   - added --store
+   ver 1.3 - 17 Oct 2026
+   - added --reporter and --report-file
+   ver 1.2 - 17 Oct 2026
+   - added --fuzz, --fuzz-runs, and --corpus
+   ver 1.1 - 17 Oct 2026
+   - added --history
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace Test {
+
+  struct TestOptions {
+    size_t shardIndex = 0;
+    size_t shardCount = 1;
+    std::string shardDurations;
+    std::string writeDurations;
+    std::string history;
+    std::string store;
+    std::string baseline;
+    bool updateBaseline = false;
+    std::vector<std::string> filters;
+    bool list = false;
+    std::vector<size_t> stressThreads;
+    size_t stressIterations = 1000;
+    std::string fuzz;
+    size_t fuzzRuns = 100000;
+    std::string corpus;
+    std::string reporter = "console";
+    std::string reportFile;
+  };
+
+  /*-- convert option value to count, rejecting junk --*/
+  inline size_t toCount(const std::string& option, const std::string& value) {
+    size_t pos = 0;
+    unsigned long long n = 0;
+    try {
+      n = std::stoull(value, &pos);
+    }
+    catch (std::exception&) {
+      pos = 0;
+    }
+    if (value.empty() || pos != value.size() || value[0] == '-')
+      throw std::invalid_argument(option + " requires a non-negative integer, got \"" + value + "\"");
+    return static_cast<size_t>(n);
+  }
+
+  /*-- convert comma separated option value to counts --*/
+  inline std::vector<size_t> toCounts(const std::string& option, const std::string& value) {
+    std::vector<size_t> counts;
+    size_t start = 0;
+    while (true) {
+      size_t comma = value.find(',', start);
+      counts.push_back(toCount(option, value.substr(start, comma - start)));
+      if (comma == std::string::npos)
+        return counts;
+      start = comma + 1;
+    }
+  }
+
+  inline TestOptions parseOptions(int argc, char* argv[]) {
+    TestOptions opts;
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      std::string name = arg, value;
+      bool hasValue = false;
+      size_t eq = arg.find('=');
+      if (eq != std::string::npos) {
+        name = arg.substr(0, eq);
+        value = arg.substr(eq + 1);
+        hasValue = true;
+      }
+      auto next = [&]() {
+        if (hasValue)
+          return value;
+        if (i + 1 >= argc)
+          throw std::invalid_argument(name + " requires a value");
+        return std::string(argv[++i]);
+      };
+      if (name == "--shard-index")
+        opts.shardIndex = toCount(name, next());
+      else if (name == "--shard-count")
+        opts.shardCount = toCount(name, next());
+      else if (name == "--shard-durations")
+        opts.shardDurations = next();
+      else if (name == "--write-durations")
+        opts.writeDurations = next();
+      else if (name == "--history")
+        opts.history = next();
+      else if (name == "--store")
+        opts.store = next();
+      else if (name == "--baseline")
+        opts.baseline = next();
+      else if (name == "--update-baseline")
+        opts.updateBaseline = true;
+      else if (name == "--filter")
+        opts.filters.push_back(next());
+      else if (name == "--list")
+        opts.list = true;
+      else if (name == "--stress")
+        opts.stressThreads = toCounts(name, next());
+      else if (name == "--stress-iterations")
+        opts.stressIterations = toCount(name, next());
+      else if (name == "--fuzz")
+        opts.fuzz = next();
+      else if (name == "--fuzz-runs")
+        opts.fuzzRuns = toCount(name, next());
+      else if (name == "--corpus")
+        opts.corpus = next();
+      else if (name == "--reporter")
+        opts.reporter = next();
+      else if (name == "--report-file")
+        opts.reportFile = next();
+      else
+        throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opts.shardCount == 0)
+      throw std::invalid_argument("--shard-count must be at least 1");
+    if (opts.shardIndex >= opts.shardCount)
+      throw std::invalid_argument("--shard-index must be less than --shard-count");
+    return opts;
+  }
+}
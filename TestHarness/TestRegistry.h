@@ -0,0 +1,222 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestRegistry.h - static self-registering test table     //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Builds the table of tests during static initialization:
+   - TEST_FUNCTION(name, tags) defines and registers bool name()
+   - TEST_CLASS(Type, tags) registers an ITest class, which is
+     constructed only when its test runs, Type may be qualified,
+     e.g., TEST_CLASS(Widgets::TestWidget)
+   - each registration is a static TestEntry node linked into the
+     registry, holding constant name, tags, and source location,
+     so registering and listing tests allocates nothing and
+     constructs no test classes
+   - registryIndex() builds the TestIndex filters match against
+     once, when first used, and extends it only if tests were
+     registered since
+   - doRegisteredTests() runs the table with an Executor, all of
+     it, or the tests a selector or TestFilter accepts, optionally
+     narrowed by a name selector, e.g., one shard's
+
+   Example:
+     TEST_FUNCTION(parsesDates, "parser fast") {
+       return Utilities::DateTime("Sat Oct 17 10:00:00 2026").year() == 126;
+     }
+     TEST_CLASS(TestWidgetClass)
+
+   Package Dependencies:
+  -----------------------
+   TestRegistry.h
+   TestHarness.h
+   TestFilter.h
+   ITest.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.4 - 17 Oct 2026
+   - registryIndex() is built once and kept, not rebuilt per run
+   ver 1.3 - 17 Oct 2026
+   - registration objects are named from __COUNTER__, so TEST_CLASS
+     accepts qualified type names
+   ver 1.2 - 17 Oct 2026
+   - added registryNames() and name selector for filtered runs
+   ver 1.1 - 17 Oct 2026
+   - added registryIndex() and filtered doRegisteredTests
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include "ITest.h"
+#include "TestHarness.h"
+#include "TestFilter.h"
+
+namespace Test {
+
+  /*-- one registered test, lives in static storage --*/
+  struct TestEntry {
+    std::string_view name;
+    std::string_view tags;
+    const char* file;
+    int line;
+    FP function;
+    std::unique_ptr<ITest>(*create)();
+    TestEntry* next = nullptr;
+
+    /*-- run function, or construct class and run its test() --*/
+    bool run() const {
+      if (function)
+        return function();
+      std::unique_ptr<ITest> pTest = create();
+      return pTest->test();
+    }
+  };
+
+  /*-- factory stored in TEST_CLASS entries --*/
+  template<typename T>
+  std::unique_ptr<ITest> makeTest() {
+    return std::make_unique<T>();
+  }
+
+  ///////////////////////////////////////////////
+  // TestRegistry class - intrusive list of entries
+
+  class TestRegistry {
+  public:
+    class iterator {
+    public:
+      explicit iterator(const TestEntry* p) : p_(p) {}
+      const TestEntry& operator*() const { return *p_; }
+      const TestEntry* operator->() const { return p_; }
+      iterator& operator++() { p_ = p_->next; return *this; }
+      bool operator==(const iterator& it) const { return p_ == it.p_; }
+      bool operator!=(const iterator& it) const { return p_ != it.p_; }
+    private:
+      const TestEntry* p_;
+    };
+
+    constexpr TestRegistry() = default;
+
+    /*-- append, so tests in a file keep their declaration order --*/
+    void add(TestEntry* pEntry) {
+      if (pTail_)
+        pTail_->next = pEntry;
+      else
+        pHead_ = pEntry;
+      pTail_ = pEntry;
+      ++size_;
+    }
+    iterator begin() const { return iterator(pHead_); }
+    iterator end() const { return iterator(nullptr); }
+    size_t size() const { return size_; }
+  private:
+    TestEntry* pHead_ = nullptr;
+    TestEntry* pTail_ = nullptr;
+    size_t size_ = 0;
+  };
+
+  /*-- constant initialized, so usable from any static initializer --*/
+  inline TestRegistry testRegistry;
+
+  struct AutoReg {
+    explicit AutoReg(TestEntry& entry) {
+      testRegistry.add(&entry);
+    }
+  };
+
+  /*---------------------------------------------------
+    execute registered tests accepted by selector,
+    all tests if selector is empty
+  */
+  inline bool doRegisteredTests(
+    const ExecutorOptions& opts = ExecutorOptions(),
+    const std::function<bool(const TestEntry&)>& selector = nullptr
+  ) {
+    Executor<ITest> ex(opts);
+    bool rtn = true;
+    for (const TestEntry& entry : testRegistry) {
+      if (selector && !selector(entry))
+        continue;
+      TestResult r = ex.execute([&entry]() { return entry.run(); }, std::string(entry.name));
+      ex.showResult(r);
+      rtn &= r.passed;
+    }
+    return rtn;
+  }
+
+  /*---------------------------------------------------
+    names and tags of registered tests, ids in registry
+    order, kept for the life of the program
+    - entries registered after the last call are added,
+      the registry only grows
+  */
+  inline const TestIndex& registryIndex() {
+    static std::mutex mtx;
+    static TestIndex index;
+    std::lock_guard<std::mutex> lock(mtx);
+    if (index.size() < testRegistry.size()) {
+      size_t id = 0;
+      for (const TestEntry& entry : testRegistry)
+        if (id++ >= index.size())
+          index.add(entry.name, entry.tags);
+      index.byName();   // sort now, so concurrent matches only read
+    }
+    return index;
+  }
+
+  /*-- names of registered tests, in registry order, e.g., for ShardPlan::selector --*/
+  inline std::vector<std::string> registryNames() {
+    std::vector<std::string> names;
+    names.reserve(testRegistry.size());
+    for (const TestEntry& entry : testRegistry)
+      names.emplace_back(entry.name);
+    return names;
+  }
+
+  /*---------------------------------------------------
+    execute registered tests filter selects, matched
+    once up front, that inSet, e.g., a shard selector,
+    also accepts
+  */
+  inline bool doRegisteredTests(
+    const ExecutorOptions& opts, const TestFilter& filter,
+    const std::function<bool(const std::string&)>& inSet = nullptr
+  ) {
+    Selection selected = filter.match(registryIndex());
+    size_t id = 0;   // selector sees every entry, in registry order
+    return doRegisteredTests(opts, [&](const TestEntry& entry) {
+      return selected[id++] && (!inSet || inSet(std::string(entry.name)));
+    });
+  }
+}
+
+#define TEST_REGISTRY_CONCAT_(a, b) a##b
+#define TEST_REGISTRY_CONCAT(a, b) TEST_REGISTRY_CONCAT_(a, b)
+
+/*-- unique identifier for one registration's statics --*/
+#define TEST_REGISTRY_ID(id, suffix) TEST_REGISTRY_CONCAT(testRegistry_, TEST_REGISTRY_CONCAT(id, suffix))
+
+/*-- entry and registrar named from id, name is only stringized --*/
+#define TEST_REGISTRY_ENTRY_(id, name, function, create, ...) \
+  static ::Test::TestEntry TEST_REGISTRY_ID(id, _entry){ \
+    name, "" __VA_ARGS__, __FILE__, __LINE__, function, create }; \
+  static ::Test::AutoReg TEST_REGISTRY_ID(id, _reg){ TEST_REGISTRY_ID(id, _entry) };
+
+/*-- define and register bool fname(), optional tags string --*/
+#define TEST_FUNCTION(fname, ...) \
+  bool fname(); \
+  TEST_REGISTRY_ENTRY_(__COUNTER__, #fname, &fname, nullptr, __VA_ARGS__) \
+  bool fname()
+
+/*-- register default constructible ITest class, optional tags string --*/
+#define TEST_CLASS(Type, ...) \
+  TEST_REGISTRY_ENTRY_(__COUNTER__, #Type, nullptr, &::Test::makeTest<Type>, __VA_ARGS__)
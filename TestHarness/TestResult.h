@@ -0,0 +1,84 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// TestResult.h - test execution records and options       //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Declares the types shared by executors and reporters:
+   - TestResult, the record of one test execution
+   - ExecutorOptions, measurements taken while tests run and
+     the Reporter that displays their results
+
+   Package Dependencies:
+  -----------------------
+   TestResult.h
+   TestClock.h
+   PerfCounters.h
+   AllocTracker.h
+   ResourceUsage.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.1 - 17 Oct 2026
+   - added resource usage, peak resident set, faults, and
+     context switches, with an optional peak limit
+   ver 1.0 - 17 Oct 2026
+   - split from TestHarness.h, so Reporter.h can use it
+*/
+#include <string>
+#include <vector>
+#include <memory>
+#include <limits>
+#include "TestClock.h"
+#include "PerfCounters.h"
+#include "AllocTracker.h"
+#include "ResourceUsage.h"
+
+namespace Test {
+
+  class Reporter;
+
+  /*---------------------------------------------------
+    record of a single test execution
+    - start and end are taken from the monotonic Clock
+    - message holds the text of a caught exception
+    - converts to bool so callers can treat it as the
+      pass/fail result
+  */
+  struct TestResult {
+    std::string name;
+    bool passed = false;
+    std::string message;
+    Clock::time_point start;
+    Clock::time_point end;
+    Nanoseconds cpuTime{ 0 };
+    bool timedOut = false;
+    PerfCounts counters;
+    AllocStats allocations;
+    ResourceUsage resources;
+
+    Nanoseconds duration() const {
+      return std::chrono::duration_cast<Nanoseconds>(end - start);
+    }
+    operator bool() const {
+      return passed;
+    }
+  };
+
+  using TestResults = std::vector<TestResult>;
+
+  /*-- optional measurements taken while each test runs --*/
+  struct ExecutorOptions {
+    bool counters = false;
+    bool allocations = false;
+    size_t maxAllocations = std::numeric_limits<size_t>::max();
+    bool resources = false;
+    long long maxPeakRss = std::numeric_limits<long long>::max();   // bytes above start, not checked for concurrent tests
+    Nanoseconds testTimeout{ 0 };     // zero means no limit
+    Nanoseconds suiteTimeout{ 0 };    // zero means no limit
+    std::shared_ptr<Reporter> reporter;  // null means defaultReporter()
+  };
+}
@@ -0,0 +1,192 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// ThreadPool.h - work-stealing pool for test execution    //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Provides ThreadPool, a fixed set of worker threads:
+   - each worker owns a task deque
+   - submit() from a worker pushes onto that worker's deque,
+     otherwise onto a shared submission queue
+   - workers pop their own deque from the back, so tasks they
+     spawn run depth first; when it is empty they take the
+     oldest submitted task, so tasks submitted from outside
+     start in submission order, e.g., longest test first; then
+     they steal from the front of the other workers' deques
+   - wait() blocks until every submitted task has completed,
+     including tasks submitted by running tasks
+   - onWorker() tells code that would start its own pool that
+     it already runs on a pool thread
+
+   Package Dependencies:
+  -----------------------
+   ThreadPool.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.3 - 17 Oct 2026
+   - added onWorker()
+   ver 1.2 - 17 Oct 2026
+   - tasks submitted from outside the pool start in submission
+     order, from a shared FIFO queue
+   ver 1.1 - 17 Oct 2026
+   - queued count is raised before a task is visible to workers
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // ThreadPool class
+
+  class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    /*-- start nThreads workers, zero means one per hardware thread --*/
+    explicit ThreadPool(size_t nThreads = 0) {
+      if (nThreads == 0)
+        nThreads = std::thread::hardware_concurrency();
+      if (nThreads == 0)
+        nThreads = 1;
+      for (size_t i = 0; i < nThreads; ++i)
+        queues_.push_back(std::make_unique<WorkQueue>());
+      for (size_t i = 0; i < nThreads; ++i)
+        workers_.emplace_back(&ThreadPool::workerProc, this, i);
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*-- finish queued work then join workers --*/
+    ~ThreadPool() {
+      wait();
+      {
+        std::lock_guard<std::mutex> l(sleepMtx_);
+        stop_ = true;
+      }
+      workCv_.notify_all();
+      for (auto& w : workers_)
+        w.join();
+    }
+    /*-- queue task for execution --*/
+    void submit(Task task) {
+      WorkQueue& q = (pOwner_ == this) ? *queues_[index_] : submitted_;
+      pending_.fetch_add(1);
+      {
+        /* count first, so a worker that takes the task never sees queued_ at zero */
+        std::lock_guard<std::mutex> l(sleepMtx_);
+        ++queued_;
+      }
+      {
+        std::lock_guard<std::mutex> l(q.mtx);
+        q.tasks.push_back(std::move(task));
+      }
+      workCv_.notify_one();
+    }
+    /*-- block until all submitted tasks have run --*/
+    void wait() {
+      std::unique_lock<std::mutex> l(doneMtx_);
+      doneCv_.wait(l, [this]() { return pending_.load() == 0; });
+    }
+    /*-- number of worker threads --*/
+    size_t size() const {
+      return workers_.size();
+    }
+    /*-- true if the calling thread is a worker of some pool --*/
+    static bool onWorker() {
+      return pOwner_ != nullptr;
+    }
+  private:
+    struct WorkQueue {
+      std::deque<Task> tasks;
+      std::mutex mtx;
+    };
+    /*-- take newest task from own deque --*/
+    bool popLocal(size_t i, Task& task) {
+      std::lock_guard<std::mutex> l(queues_[i]->mtx);
+      if (queues_[i]->tasks.empty())
+        return false;
+      task = std::move(queues_[i]->tasks.back());
+      queues_[i]->tasks.pop_back();
+      return true;
+    }
+    /*-- take oldest task submitted from outside the pool --*/
+    bool popSubmitted(Task& task) {
+      std::lock_guard<std::mutex> l(submitted_.mtx);
+      if (submitted_.tasks.empty())
+        return false;
+      task = std::move(submitted_.tasks.front());
+      submitted_.tasks.pop_front();
+      return true;
+    }
+    /*-- take oldest task from some other worker's deque --*/
+    bool steal(size_t i, Task& task) {
+      for (size_t k = 1; k < queues_.size(); ++k) {
+        WorkQueue& q = *queues_[(i + k) % queues_.size()];
+        std::lock_guard<std::mutex> l(q.mtx);
+        if (q.tasks.empty())
+          continue;
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+      }
+      return false;
+    }
+    /*-- function executed by each worker thread --*/
+    void workerProc(size_t i) {
+      pOwner_ = this;
+      index_ = i;
+      while (true) {
+        Task task;
+        if (popLocal(i, task) || popSubmitted(task) || steal(i, task)) {
+          {
+            std::lock_guard<std::mutex> l(sleepMtx_);
+            --queued_;
+          }
+          try {
+            task();
+          }
+          catch (...) {
+            /* tasks report their own failures, never stall wait() */
+          }
+          if (pending_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> l(doneMtx_);
+            doneCv_.notify_all();
+          }
+          continue;
+        }
+        std::unique_lock<std::mutex> l(sleepMtx_);
+        workCv_.wait(l, [this]() { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0)
+          return;
+      }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    WorkQueue submitted_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> pending_{ 0 };
+    std::mutex sleepMtx_;
+    std::condition_variable workCv_;
+    size_t queued_ = 0;
+    bool stop_ = false;
+    std::mutex doneMtx_;
+    std::condition_variable doneCv_;
+
+    /*-- identify pool and deque owned by calling worker thread --*/
+    inline static thread_local ThreadPool* pOwner_ = nullptr;
+    inline static thread_local size_t index_ = 0;
+  };
+}
@@ -0,0 +1,249 @@
+#pragma once
+/////////////////////////////////////////////////////////////
+// Watchdog.h - deadline enforcement for test execution    //
+//                                                         //
+// Jim Fawcett, Teaching Professor Emeritus, ECE, Syr Univ //
+/////////////////////////////////////////////////////////////
+/*
+   Package Responsibilities
+  --------------------------
+   Provides:
+   - Watchdog, one timer thread serving all deadlines from a
+     min-heap; arm() registers a callback to run at a deadline,
+     disarm() cancels it
+   - DeadlineRunner, runs jobs on reusable runner threads while
+     the caller waits for completion or for the Watchdog to
+     signal that the job's deadline passed
+
+   A job that misses its deadline can't be stopped safely in C++.
+   Its runner thread is abandoned, i.e., left running detached,
+   and a fresh runner serves the next job, so the rest of a suite
+   keeps running.  Anything an abandoned job references must stay
+   alive until it returns, or until the process exits.
+
+   Package Dependencies:
+  -----------------------
+   Watchdog.h
+   TestClock.h
+
+   Maintenance History:
+  ----------------------
+   ver 1.0 - 17 Oct 2026
+   - first release
+*/
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include "TestClock.h"
+
+namespace Test {
+
+  ///////////////////////////////////////////////
+  // Watchdog class
+
+  class Watchdog {
+  public:
+    using Id = uint64_t;
+
+    Watchdog() : thread_(&Watchdog::threadProc, this) {}
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+    ~Watchdog() {
+      {
+        std::lock_guard<std::mutex> l(mtx_);
+        stop_ = true;
+      }
+      cv_.notify_one();
+      thread_.join();
+    }
+    /*-- process wide instance, started on first use --*/
+    static Watchdog& instance() {
+      static Watchdog watchdog;
+      return watchdog;
+    }
+    /*-- run onExpire on the timer thread at deadline --*/
+    Id arm(Clock::time_point deadline, std::function<void()> onExpire) {
+      Id id;
+      bool earliest;
+      {
+        std::lock_guard<std::mutex> l(mtx_);
+        id = nextId_++;
+        earliest = heap_.empty() || deadline < heap_.top().deadline;
+        heap_.push(Entry{ deadline, id });
+        callbacks_.emplace(id, std::move(onExpire));
+      }
+      if (earliest)
+        cv_.notify_one();
+      return id;
+    }
+    /*-- cancel, returns false if callback already ran --*/
+    bool disarm(Id id) {
+      std::lock_guard<std::mutex> l(mtx_);
+      return callbacks_.erase(id) > 0;
+    }
+  private:
+    struct Entry {
+      Clock::time_point deadline;
+      Id id;
+      bool operator>(const Entry& e) const {
+        return deadline > e.deadline;
+      }
+    };
+    /*-- disarmed entries stay in heap until they reach the top --*/
+    void threadProc() {
+      std::unique_lock<std::mutex> l(mtx_);
+      while (!stop_) {
+        if (heap_.empty()) {
+          cv_.wait(l);
+          continue;
+        }
+        Entry top = heap_.top();
+        auto iter = callbacks_.find(top.id);
+        if (iter == callbacks_.end()) {
+          heap_.pop();
+          continue;
+        }
+        if (Clock::now() < top.deadline) {
+          cv_.wait_until(l, top.deadline);
+          continue;
+        }
+        std::function<void()> onExpire = std::move(iter->second);
+        callbacks_.erase(iter);
+        heap_.pop();
+        l.unlock();
+        onExpire();
+        l.lock();
+      }
+    }
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+    std::unordered_map<Id, std::function<void()>> callbacks_;
+    Id nextId_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+  };
+
+  ///////////////////////////////////////////////
+  // DeadlineRunner class
+
+  class DeadlineRunner {
+  public:
+    explicit DeadlineRunner(Watchdog& watchdog = Watchdog::instance())
+      : watchdog_(watchdog) {}
+    DeadlineRunner(const DeadlineRunner&) = delete;
+    DeadlineRunner& operator=(const DeadlineRunner&) = delete;
+
+    /*-- stop idle runners, abandoned runners exit when their job returns --*/
+    ~DeadlineRunner() {
+      std::lock_guard<std::mutex> l(idleMtx_);
+      for (auto& pState : idle_) {
+        {
+          std::lock_guard<std::mutex> sl(pState->mtx);
+          pState->stop = true;
+        }
+        pState->cv.notify_one();
+      }
+    }
+    /*---------------------------------------------------
+      run job on a runner thread, waiting until it
+      completes or deadline passes
+      - returns true if job completed, false if its
+        runner was abandoned at the deadline
+    */
+    bool run(std::function<void()> job, Clock::time_point deadline) {
+      std::shared_ptr<State> pState = acquire();
+      uint64_t gen;
+      {
+        std::lock_guard<std::mutex> l(pState->mtx);
+        gen = ++pState->gen;
+        pState->job = std::move(job);
+        pState->done = false;
+        pState->timedOut = false;
+      }
+      pState->cv.notify_all();
+
+      Watchdog::Id id = watchdog_.arm(deadline, [pState, gen]() {
+        {
+          std::lock_guard<std::mutex> l(pState->mtx);
+          if (pState->gen != gen || pState->done)
+            return;
+          pState->timedOut = true;
+        }
+        pState->cv.notify_all();
+      });
+
+      std::unique_lock<std::mutex> l(pState->mtx);
+      pState->cv.wait(l, [&]() { return pState->done || pState->timedOut; });
+      if (pState->done) {
+        l.unlock();
+        watchdog_.disarm(id);
+        release(pState);
+        return true;
+      }
+      pState->abandoned = true;
+      return false;
+    }
+  private:
+    struct State {
+      std::mutex mtx;
+      std::condition_variable cv;
+      std::function<void()> job;
+      uint64_t gen = 0;
+      bool done = true;
+      bool timedOut = false;
+      bool abandoned = false;
+      bool stop = false;
+    };
+    /*-- runner threads are detached, they own a share of their state --*/
+    static void runnerProc(std::shared_ptr<State> pState) {
+      std::unique_lock<std::mutex> l(pState->mtx);
+      while (true) {
+        pState->cv.wait(l, [&]() { return pState->stop || pState->job; });
+        if (!pState->job)
+          return;
+        std::function<void()> job = std::move(pState->job);
+        pState->job = nullptr;
+        l.unlock();
+        try {
+          job();
+        }
+        catch (...) {
+          /* jobs report their own failures */
+        }
+        job = nullptr;
+        l.lock();
+        pState->done = true;
+        if (pState->abandoned)
+          return;
+        pState->cv.notify_all();
+      }
+    }
+    std::shared_ptr<State> acquire() {
+      {
+        std::lock_guard<std::mutex> l(idleMtx_);
+        if (!idle_.empty()) {
+          std::shared_ptr<State> pState = idle_.back();
+          idle_.pop_back();
+          return pState;
+        }
+      }
+      auto pState = std::make_shared<State>();
+      std::thread(&DeadlineRunner::runnerProc, pState).detach();
+      return pState;
+    }
+    void release(std::shared_ptr<State> pState) {
+      std::lock_guard<std::mutex> l(idleMtx_);
+      idle_.push_back(std::move(pState));
+    }
+    Watchdog& watchdog_;
+    std::mutex idleMtx_;
+    std::vector<std::shared_ptr<State>> idle_;
+  };
+}
@@ -1,15 +1,124 @@
 #pragma once
 ///////////////////////////////////////////////////////////////////
-// TestUtilities.h - Display helper classes                      //
+// TestAssertions.h - assertions and test failure recording      //
 //                                                               //
 // Jim Fawcett, Teaching Professor Emeritus, ECE, Syracuse Univ  //
 ///////////////////////////////////////////////////////////////////
+/*
+   Assert, Requires, and Ensures display a failed predicate or,
+   if asked, throw std::runtime_error.
 
+   TEST_CHECK and friends record a failed predicate, with file
+   and line, in a thread_local Failure and return false from the
+   test, so failing costs no more than returning.  Executors read
+   the Failure to explain why a test failed.  Call
+   throwOnFailure(true) to make them throw instead.
+
+     bool testSize() {
+       Widget w;
+       TEST_REQUIRES(w.empty());
+       w.add(3);
+       TEST_CHECK_MSG(w.size() == 1, "after one add");
+       return true;
+     }
+*/
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 
 namespace Test {
 
+  /*-- first failed check since the slot was cleared --*/
+  struct Failure {
+    const char* kind = "";      // "check", "requires", or "ensures"
+    const char* check = "";     // predicate text
+    const char* file = "";
+    size_t line = 0;
+    std::string message;        // optional, from TEST_CHECK_MSG
+    size_t count = 0;           // failed checks since cleared
+  };
+
+  /*-- this thread's failure slot --*/
+  inline Failure& failureSlot() {
+    thread_local Failure failure;
+    return failure;
+  }
+  inline bool& throwFlag() {
+    thread_local bool doThrow = false;
+    return doThrow;
+  }
+  /*-- make this thread's failed checks throw instead of return --*/
+  inline void throwOnFailure(bool doThrow) {
+    throwFlag() = doThrow;
+  }
+  inline void clearFailure() {
+    failureSlot() = Failure();
+  }
+  inline bool failureRecorded() {
+    return failureSlot().count > 0;
+  }
+  /*-- "file:line: check failed: predicate, message", no location if file is empty --*/
+  inline std::string describeFailure(const Failure& f) {
+    if (f.count == 0)
+      return std::string();
+    std::string file = f.file;
+    size_t slash = file.find_last_of("/\\");
+    if (slash != std::string::npos)
+      file.erase(0, slash + 1);
+    std::string text = file.empty() ? std::string() : file + ":" + std::to_string(f.line) + ": ";
+    text += std::string(f.kind) + " failed: " + f.check;
+    if (!f.message.empty())
+      text += ", " + f.message;
+    return text;
+  }
+  /*---------------------------------------------------
+    record a failed check, keeping the first, and
+    return false for the test to return
+    - throws std::runtime_error instead if
+      throwOnFailure(true) was called on this thread
+  */
+  inline bool recordFailure(
+    const char* kind, const char* check, const char* file, size_t line, std::string message = std::string()
+  ) {
+    Failure& f = failureSlot();
+    if (f.count++ == 0) {
+      f.kind = kind;
+      f.check = check;
+      f.file = file;
+      f.line = line;
+      f.message = std::move(message);
+    }
+    if (throwFlag())
+      throw std::runtime_error(describeFailure(f));
+    return false;
+  }
+
+  /*---------------------------------------------------
+    gives code, e.g., one test run, a cleared failure
+    slot and restores the enclosing one on exit, so
+    nested runs don't lose or leak failures
+  */
+  class FailureScope {
+  public:
+    FailureScope() : outer_(std::move(failureSlot())) {
+      clearFailure();
+    }
+    FailureScope(const FailureScope&) = delete;
+    FailureScope& operator=(const FailureScope&) = delete;
+    ~FailureScope() {
+      failureSlot() = std::move(outer_);
+    }
+    bool failed() const {
+      return failureRecorded();
+    }
+    std::string message() const {
+      return describeFailure(failureSlot());
+    }
+  private:
+    Failure outer_;
+  };
+
   inline void Assert(bool predicate, const std::string& message = "", size_t ln = 0, bool doThrow = false) {
     if (predicate)
       return;
@@ -19,7 +128,7 @@ namespace Test {
     if (message.size() > 0)
       sentMsg += "\n  message: \"" + message + "\"";
     if (doThrow)
-      throw std::exception(sentMsg.c_str());
+      throw std::runtime_error(sentMsg);
     else
       std::cout << "\n  " + sentMsg;
   }
@@ -30,7 +139,7 @@ namespace Test {
     std::string sentMsg = "Requires " + message + " raised";
     sentMsg += " at line number " + std::to_string(lineNo);
     if (doThrow)
-      throw std::exception(sentMsg.c_str());
+      throw std::runtime_error(sentMsg);
     else
       std::cout << "\n  " + sentMsg;
   }
@@ -41,8 +150,25 @@ namespace Test {
     std::string sentMsg = "Ensures " + message + " raised";
     sentMsg += " at line number " + std::to_string(lineNo);
     if (doThrow)
-      throw std::exception(sentMsg.c_str());
+      throw std::runtime_error(sentMsg);
     else
       std::cout << "\n  " + sentMsg;
   }
-}
\ No newline at end of file
+}
+
+/*-- fail the enclosing bool test if predicate is false --*/
+#define TEST_CHECK(predicate) \
+  do { if (!(predicate)) return ::Test::recordFailure("check", #predicate, __FILE__, __LINE__); } while (false)
+
+#define TEST_CHECK_MSG(predicate, message) \
+  do { if (!(predicate)) return ::Test::recordFailure("check", #predicate, __FILE__, __LINE__, message); } while (false)
+
+#define TEST_REQUIRES(predicate) \
+  do { if (!(predicate)) return ::Test::recordFailure("requires", #predicate, __FILE__, __LINE__); } while (false)
+
+#define TEST_ENSURES(predicate) \
+  do { if (!(predicate)) return ::Test::recordFailure("ensures", #predicate, __FILE__, __LINE__); } while (false)
+
+/*-- TEST_CHECK for coroutine tests returning Task<bool> --*/
+#define TEST_CO_CHECK(predicate) \
+  do { if (!(predicate)) co_return ::Test::recordFailure("check", #predicate, __FILE__, __LINE__); } while (false)
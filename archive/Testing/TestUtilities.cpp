@@ -38,9 +38,9 @@ int main()
   TestExecutive::TestItem ti2{ test_always_fails, "test_always_fails" };
   TestExecutive::TestItem ti3{ test_always_throws, "test_always_throws" };
   
-  ex.registerTest(ti1);
-  ex.registerTest(ti2);
-  ex.registerTest(ti3);
+  ex.registerTest(std::move(ti1));
+  ex.registerTest(std::move(ti2));
+  ex.registerTest(std::move(ti3));
 
   bool result = ex.doTests();
   if (result == true)
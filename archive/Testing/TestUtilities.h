@@ -1,7 +1,7 @@
 #pragma once
 ///////////////////////////////////////////////////////////////////////
 // TestUtilities.h - provides single-user test harness               //
-// ver 1.0                                                           //
+// ver 1.1                                                           //
 // Language:    C++, Visual Studio 2017                              //
 // Application: Most Projects, CSE687 - Object Oriented Design       //
 // Author:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -17,9 +17,13 @@
 * Required Files:
 * ---------------
 *   TestUtilities.h
+*   ../../TestHarness/TestCallable.h
 *
 * Maintenance History:
 * --------------------
+* ver 1.1 : 17 Oct 2026
+* - tests are held in move-only TestCallable instead of std::function,
+*   and are no longer copied when registered or executed
 * ver 1.0 : 12 Jan 2018
 * - first release
 * - refactored from earlier Utilities.h
@@ -35,7 +39,9 @@
 */
 
 #include <vector>
+#include <string>
 #include <iostream>
+#include "../../TestHarness/TestCallable.h"
 
 /////////////////////////////////////////////////////////////////////
 // TestExecutor class
@@ -46,14 +52,14 @@ template<typename T>
 class TestExecutor
 {
 public:
-  bool execute(T t, const std::string& name, std::ostream& out = std::cout);
+  bool execute(T& t, const std::string& name, std::ostream& out = std::cout);
 private:
   void check(bool result, std::ostream& out);
 };
 //----< execute tests in the context of a try-catch block >----------
 
 template <typename T>
-bool TestExecutor<T>::execute(T t, const std::string& name, std::ostream& out)
+bool TestExecutor<T>::execute(T& t, const std::string& name, std::ostream& out)
 {
   bool result = false;
   try
@@ -88,7 +94,7 @@ void TestExecutor<T>::check(bool result, std::ostream& out)
 class TestExecutive
 {
 public:
-  using Test = std::function<bool()>;
+  using Test = ::Test::TestCallable;
   using TestItem = struct {
     Test test;
     std::string testName;
@@ -104,20 +110,19 @@ private:
 
 inline void TestExecutive::registerTest(Test t, const std::string& testName)
 {
-  TestItem ts{ t, testName };
-  tests_.push_back(ts);
+  tests_.push_back(TestItem{ std::move(t), testName });
 }
 
 inline void TestExecutive::registerTest(TestItem ts)
 {
-  tests_.push_back(ts);
+  tests_.push_back(std::move(ts));
 }
 
 inline bool TestExecutive::doTests()
 {
   TestExecutor<Test> tester;
   bool result = true;
-  for (auto item : tests_)
+  for (auto& item : tests_)
   {
     bool tResult = tester.execute(item.test, item.testName);
     if (tResult == false)